@@ -18,12 +18,94 @@
  */
 #ifndef EVOLUTION
 #define EVOLUTION
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* sched_setaffinity */
+#endif
+#include <sched.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <limits.h>
 #include "evolution.h"
 #include "C-Utils/Debug/src/debug.h"
 
 
-/* Evolution mutex */
-static pthread_mutex_t ev_mutex = PTHREAD_MUTEX_INITIALIZER;
+/* counts the created Evolutions, so each one gets different seeds */
+static uint32_t ev_instances = 0;
+
+/**
+ * Magic number marking an initialized shared memory region
+ */
+#define EV_SHM_MAGIC 0x45564f4c
+
+/**
+ * Header of the shared memory region in process mode,
+ * followed by one EvShmRing for each process and than
+ * by the EV_SHM_RING_SLOTS slots of each ring
+ */
+typedef struct {
+  uint32_t magic;          /* EV_SHM_MAGIC if initialized             */
+  int      num_processes;  /* number of processes (and rings)         */
+  uint64_t migrant_size;   /* max size of one serialized individual   */
+  uint64_t slot_size;      /* size of one slot (header + migrant)     */
+  char     pad[40];        /* the rings start on a new cache line     */
+} EvShmHeader;
+
+/**
+ * Single producer single consumer ring of migrants, process i - 1
+ * pushes at head and process i pops at tail, both on different 
+ * cache lines to avoid false sharing between the processes
+ */
+typedef struct {
+  uint64_t head;
+  char     pad_head[56];
+  uint64_t tail;
+  char     pad_tail[56];
+} EvShmRing;
+
+/**
+ * One migrant inside a ring, followed by the serialized individual
+ */
+typedef struct {
+  int64_t  fitness;
+  uint64_t size;
+} EvShmSlot;
+
+/* access the parts of the shared memory region */
+#define EV_SHM_HEADER(SHM) ((EvShmHeader *) (SHM))
+#define EV_SHM_RING(SHM, I)                                                   \
+  (((EvShmRing *) ((char *) (SHM) + sizeof(EvShmHeader))) + (I))
+#define EV_SHM_SLOT(SHM, I, S)                                                \
+  ((EvShmSlot *) ((char *) (SHM) + sizeof(EvShmHeader) +                      \
+                  sizeof(EvShmRing) * EV_SHM_HEADER(SHM)->num_processes +     \
+                  EV_SHM_HEADER(SHM)->slot_size *                             \
+                  ((uint64_t) (I) * EV_SHM_RING_SLOTS + (S))))
+
+/**
+ * Hint for the cpu that we are spinning
+ */
+#if defined(__i386__) || defined(__x86_64__)
+#define EV_CPU_RELAX() __builtin_ia32_pause()
+#else
+#define EV_CPU_RELAX() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+/**
+ * The alias table compares the low 31 bits of rand128 with the
+ * probabilities, so EV_ALIAS_FULL is an probability of one
+ */
+#define EV_ALIAS_MASK 0x7fffffffu
+#define EV_ALIAS_FULL (EV_ALIAS_MASK + 1u)
+
+/**
+ * Number of tries to pick an second parent different from the first
+ * with the parent selection, before it is picked uniformly
+ */
+#define EV_PARENT_RETRIES 4
 
 /********************/
 /* static functions */
@@ -34,6 +116,12 @@ static pthread_mutex_t ev_mutex = PTHREAD_MUTEX_INITIALIZER;
  */
 static void ev_init_tc_and_ivs(Evolution *ev);
 
+/**
+ * Sets up the individuals behind start (up to overall_end)
+ * wich are created on first use in lazy init mode
+ */
+static void ev_init_lazy_ivs(Evolution *ev, int start);
+
 /**
  * Returns wether the given EvInitArgs are valid or not
  */
@@ -76,6 +164,85 @@ static inline void ev_init_greedy(Evolution *ev);
  */
 static inline void ev_switch_ivs(Evolution *ev);
 
+/**
+ * Sets the chunk size for the work-stealing scheduler
+ * from the number of individuals calculated by one thread
+ */
+static inline void ev_init_chunks(Evolution *ev, int ivs_per_thread);
+
+/**
+ * Resets the work-stealing cursors of all threads
+ * to their own slice before an generation starts
+ */
+static inline void ev_reset_chunks(Evolution *ev);
+
+/**
+ * Takes the next chunk of work for the given thread, first from
+ * the front of its own slice, then by stealing from the back of
+ * the slices of the other threads.
+ * Returns 0 if there is no work left in this generation
+ */
+static inline char ev_next_chunk(EvThreadArgs *evt, int *start, int *end);
+
+/**
+ * Sets the work of thread j for each generation
+ */
+static inline void ev_set_thread_func(Evolution *ev, 
+                                      int j, 
+                                      void *(*func) (void *));
+
+/**
+ * Wakeup the threads to start the next generation
+ */
+static void ev_start_threads(Evolution *ev);
+
+/**
+ * Waits untill all threads finished the current generation
+ * and calculates the barrier wait time
+ */
+static void ev_wait_threads(Evolution *ev);
+
+/**
+ * Returns the current (monotonic) time in nanoseconds
+ */
+static inline uint64_t ev_time_ns(void);
+
+/**
+ * Spins and than sleeps on an futex untill *addr != val,
+ * returns the new value of *addr
+ */
+static uint32_t ev_spin_wait(uint32_t *addr, 
+                             uint32_t val, 
+                             uint32_t *sleepers, 
+                             int *spin);
+
+/**
+ * Starts the threads of the spin barrier
+ */
+static void ev_start_barrier(Evolution *ev);
+
+/**
+ * Adds an Evolution to the clients of the given pool
+ */
+static void ev_pool_add(EvPool *pool, Evolution *ev);
+
+/**
+ * Removes an Evolution from the clients of the given pool
+ */
+static void ev_pool_remove(EvPool *pool, Evolution *ev);
+
+/**
+ * Returns the Evolution wich gets the next thread of the pool
+ * (round robin) and sets task to the task to be done, 
+ * or NULL if there is no task (pool must be locked)
+ */
+static Evolution *ev_pool_next_task(EvPool *pool, int *task);
+
+/**
+ * Stops the threads of the spin barrier
+ */
+static void ev_stop_barrier(Evolution *ev);
+
 /**
  * Wakeup the Threadabel functions
  * an waits untill all work is done
@@ -84,6 +251,123 @@ static inline void ev_switch_ivs(Evolution *ev);
  */
 static inline void evolute_ivs(Evolution *ev);
 
+/**
+ * Moves the k best individuals to the front of the population 
+ * (unsorted, but with the best individual at index zero)
+ */
+static void ev_partition(Evolution *ev, int k);
+
+/**
+ * Fills the fitness keys [start, start + len) from the population
+ */
+static void ev_keys_fill(Evolution *ev, int start, int len);
+
+/**
+ * Permutes the population [start, start + len) 
+ * into the order of the fitness keys
+ */
+static void ev_keys_store(Evolution *ev, int start, int len);
+
+/**
+ * Allocates the genome slab of the given thread slice in arena mode
+ */
+static void ev_arena_slab(Evolution *ev, int slab);
+
+/**
+ * Initializes the genome of the individual at the given 
+ * possition inside its slab and returns it
+ */
+static void *ev_arena_init_at(Evolution *ev, int i, void *opt);
+
+/**
+ * Copies the best individual out of the arena into arena_best,
+ * its genome belongs to the caller of evolute
+ */
+static void ev_arena_release_best(Evolution *ev);
+
+/**
+ * Materializes the pending offsprings of the population [0, end)
+ * in delta mode: clones their parent and applies their patch
+ * (on all threads)
+ */
+static void ev_delta_apply(Evolution *ev, int end);
+
+/**
+ * Materializes the pending offsprings of the population [start, end)
+ */
+static void ev_delta_apply_part(Evolution *ev, int start, int end, void *opt);
+
+/**
+ * Thread function wich materializes the offsprings of its part 
+ * of [0, delta_end)
+ */
+static void *threadable_delta_apply(void *arg);
+
+/**
+ * Returns the index of one parent out of the parents [base, base + n)
+ * depending on the parent selection
+ */
+static int ev_pick_parent(Evolution *ev, int base, int n, rand128_t *v_rand);
+
+/**
+ * Returns the index of an second parent out of the parents 
+ * [base, base + n) wich differs from the first one (if n > 1)
+ */
+static int ev_pick_second_parent(Evolution *ev, 
+                                 int first, 
+                                 int base, 
+                                 int n, 
+                                 rand128_t *v_rand);
+
+/**
+ * Builds the alias table over the parents [0, overall_start)
+ * for the proportional or the rank selection
+ */
+static void ev_alias_build(Evolution *ev);
+
+/**
+ * Sorts the population with an LSD radix sort over the fitness
+ */
+static void ev_radix_sort(Evolution *ev, char parallel);
+
+/**
+ * Runs the current radix phase on the given number of parts
+ * (on the threads if there is more than one part)
+ */
+static void ev_radix_run(Evolution *ev, int parts);
+
+/**
+ * Runs the current radix phase for one part of the population
+ */
+static void ev_radix_part(Evolution *ev, int part, int parts);
+
+/**
+ * Turns the bucket counts of the parts into the offsets where each part 
+ * scatters its items, returns 0 if all items are in the same bucket
+ */
+static char ev_radix_offsets(Evolution *ev, int parts);
+
+/**
+ * Thread function wich runs the current radix phase for its part
+ */
+static void *threadable_radix(void *arg);
+
+/**
+ * Sorts the new individuals of each thread slice (in parallel)
+ * and merges them with the sorted survivors
+ */
+static void ev_merge_selection(Evolution *ev);
+
+/**
+ * Merges the sorted runs [lo, mid) and [mid, hi) of the population
+ */
+static void ev_merge_runs(Evolution *ev, int lo, int mid, int hi);
+
+/**
+ * Thread function wich sorts the slice of one thread
+ */
+static void *threadable_sort_slice(void *arg);
+
 /**
  * Wakeup the Threadabel functions
  * an waits untill all work is done
@@ -95,6 +379,95 @@ static inline void evolute_ivs(Evolution *ev);
  */
 static inline void greedy_ivs(Evolution *ev);
 
+/**
+ * in steady state mode each thread has its own private offspring
+ * individual and each slot of the population is guarded by a lock
+ */
+static void ev_init_steady_state_ivs(Evolution *ev);
+
+/**
+ * sets up the threads for steady state mode
+ */
+static inline void ev_init_steady_state(Evolution *ev);
+
+/**
+ * Wakeup the steady state threads
+ * an waits untill all generations are done
+ * or continue_ev returned 0
+ */
+static inline void steady_state_ivs(Evolution *ev);
+
+/**
+ * sets up one island for each thread
+ */
+static inline void ev_init_islands(Evolution *ev);
+
+/**
+ * Wakeup the island threads for one migration interval
+ * and migrates the elites between the islands afterwards,
+ * untill all generations are done or continue_ev returned 0
+ */
+static inline void islands_ivs(Evolution *ev);
+
+/**
+ * Copys the elites of each island into the place of the 
+ * worst individuals of the next islands (depending on the topology)
+ */
+static void ev_migrate(Evolution *ev);
+
+/**
+ * Returns the size of an shared memory region for 
+ * num_processes processes with the given slot size
+ */
+static inline size_t ev_shm_size(int num_processes, uint64_t slot_size);
+
+/**
+ * Maps the shared memory region of an process mode evolution,
+ * returns NULL if it dosn't exists or dosn't fit to the args
+ */
+static void *ev_shm_open(EvInitArgs *args, size_t *size);
+
+/**
+ * Pushes the best individuals into the ring of the next process
+ * (migrants are droped if the ring is full)
+ */
+static void ev_shm_export(Evolution *ev);
+
+/**
+ * Pops the migrants of the previous process into 
+ * the place of the worst new individuals
+ */
+static void ev_shm_import(Evolution *ev);
+
+/**
+ * Pins the calling process to its part of the available cpus
+ */
+static void ev_pin_process(int index, int num_processes);
+
+/**
+ * Returns the cpu of each thread depending on the affinity flags, 
+ * or NULL if the threads should not be pinned
+ */
+static int *ev_thread_cpus(EvInitArgs *args);
+
+/**
+ * Pins the calling thread to the cpu of the given thread args
+ * and moves the (page aligned) thread args to its NUMA node
+ */
+static void ev_pin_thread(EvThreadArgs *evt);
+
+/**
+ * Runs a short evolution with the given args and returns 
+ * the nanoseconds per generation (UINT64_MAX if the args are invalid)
+ */
+static uint64_t ev_calibrate(EvInitArgs *args);
+
+/**
+ * Returns the signature of the given args (and key) 
+ * under wich the tuned settings are cached
+ */
+static uint64_t ev_tune_signature(EvInitArgs *args, const char *key);
+
 /**
  * Initializes the evolution process
  * by configurating and starting the threads
@@ -104,9 +477,57 @@ static inline void init_evolute(Evolution *ev);
 
 /**
  * Finishes the Evolution progresse by
- * shutting down the threads
+ * shutting down the threads and returns the best individual
+ */
+static inline Individual *close_evolute(Evolution *ev);
+
+/**
+ * Recombinates two random individuals out of the parents 
+ * [base, base + n) into the individual at index j
+ */
+static int ev_recombinate_at(Evolution *ev, 
+                             int j, 
+                             int base, 
+                             int n, 
+                             rand128_t *v_rand, 
+                             void *opt,
+                             EvThreadArgs *evt);
+
+/**
+ * Clones the individual at index src into the 
+ * individual at index j and mutates it
+ */
+static int ev_mutate_at(Evolution *ev, 
+                        int j, 
+                        int src, 
+                        void *opt, 
+                        EvThreadArgs *evt);
+
+/**
+ * Calculates the fitness of the individual at index j, or submits it
+ * in async fitness mode (if evt is not NULL).
+ * Returns the number of individuals better than their bound, 
+ * wich were completed during this call
+ */
+static int ev_fitness_at(Evolution *ev, 
+                         int j, 
+                         int64_t bound, 
+                         void *opt, 
+                         EvThreadArgs *evt);
+
+/**
+ * Completes one submitted individual of the given thread
+ * (waits for it if wait is set) and returns 1 if it is
+ * better than its bound, 0 otherwise or -1 if none was completed
+ * (never if wait is set and individuals are in flight)
  */
-static inline void close_evolute(Evolution *ev);
+static int ev_complete_fitness(Evolution *ev, EvThreadArgs *evt, char wait);
+
+/**
+ * Waits untill all individuals submitted by the given thread are
+ * completed, returns the number of them wich are better than their bound
+ */
+static int ev_drain_fitness(Evolution *ev, EvThreadArgs *evt);
 
 /**
  * Parallel recombinate
@@ -130,6 +551,89 @@ static void *threadable_mutation_onely_rand(void *arg);
  */
 static void *threadable_greedy(void *arg);
 
+/**
+ * Thread function to do greedy without synchronization,
+ * runs rounds untill all generations are done
+ */
+static void *threadable_greedy_async(void *arg);
+
+/**
+ * Adopts the published best greedy individual 
+ * if it is better and its owner isn't updating it
+ */
+static void ev_greedy_adopt(Evolution *ev, EvThreadArgs *evt);
+
+/**
+ * Publishes the greedy best of the given thread 
+ * if it is better than the published one
+ */
+static void ev_greedy_publish(Evolution *ev, EvThreadArgs *evt);
+
+/**
+ * Called each time all threads together did num_threads rounds in
+ * async greedy mode, updates the EvolutionInfo and calls continue_ev
+ */
+static void ev_greedy_generation(Evolution *ev, int generation, void *opt);
+
+/**
+ * Runs the async greedy threads untill all generations are done
+ * or continue_ev returned 0 and moves the best individual to index zero
+ */
+static void greedy_async_ivs(Evolution *ev);
+
+/**
+ * Thread function to do steady state evolution
+ */
+static void *threadable_steady_state(void *arg);
+
+/**
+ * Thread function to evolve one island
+ */
+static void *threadable_island(void *arg);
+
+/**
+ * Thread function wich measures the time of the generation work
+ */
+static void *threadable_timed(void *arg);
+
+/**
+ * Thread function of the spin barrier, 
+ * runs the generation work untill it is stoped
+ */
+static void *threadable_barrier(void *arg);
+
+/**
+ * Thread function of the shared pool, runs the 
+ * tasks of the Evolutions untill the pool is freed
+ */
+static void *threadable_pool(void *arg);
+
+/**
+ * Steady state evolution for the thread with the given index
+ */
+static void ev_steady_state(Evolution *ev, int index, void *opt);
+
+/**
+ * Called each time one generation worth of offsprings are
+ * produced in steady state mode, updates the EvolutionInfo
+ * and calls continue_ev
+ */
+static void ev_steady_state_generation(Evolution *ev, 
+                                       int generation, 
+                                       void *opt);
+
+/**
+ * Called at each generation change: takes a requested snapshot of 
+ * the best individual and returns 0 if the evolution was cancelled
+ * or continue_ev returned 0 (opt are the opts of the calling thread)
+ */
+static char ev_continue(Evolution *ev, void *opt);
+
+/**
+ * Thread function wich runs evolute for an EvAsync handle
+ */
+static void *threadable_async(void *arg);
+
 /**
  * Initializes Thread Clients and Individuals serialized
  */
@@ -168,19 +672,19 @@ static void seriel_mutation_onely_1half(Evolution *ev);
 static void seriel_mutation_onely_rand(Evolution *ev);
 
 /**
- * Functions for sorting the population by fitness
+ * Functions for sorting the fitness keys of the population
  * macro versions
  */
-static inline char ev_bigger(Individual *a, Individual *b) {
-  return a->fitness > b->fitness;
+static inline char ev_key_bigger(EvKey a, EvKey b) {
+  return a.key > b.key;
 }
 
-static inline char ev_smaler(Individual *a, Individual *b) {
-  return a->fitness < b->fitness;
+static inline char ev_key_smaler(EvKey a, EvKey b) {
+  return a.key < b.key;
 }
 
-static inline char ev_equal(Individual *a, Individual *b) {
-  return a->fitness == b->fitness;
+static inline char ev_key_equal(EvKey a, EvKey b) {
+  return a.key == b.key;
 }
 
 /**
@@ -191,56 +695,193 @@ static inline char ev_equal(Individual *a, Individual *b) {
 #define EV_FITNESS_AT(EV, I) (EV)->population[I]->fitness 
 
 /**
- * Calculates the fittnes of the individual
- * at the given possition in the given Evolution
- * with the given opts
+ * Allocates the individual at the given possition
+ * in lazy init mode if it wasn't used before
+ * (uninitialized, because it is overridden by the breeding)
  */
-#define EV_CALC_FITNESS_AT(EV, I, OPTS)                                       \
-  (EV)->population[I]->fitness = (EV)->fitness((EV)->population[I], OPTS)
+#define EV_LAZY_IV_AT(EV, I, OPT)                             \
+  do {                                                        \
+    if ((EV)->population[I]->iv == NULL)                      \
+      (EV)->population[I]->iv = (EV)->alloc_iv != NULL ?      \
+                                (EV)->alloc_iv(OPT) :         \
+                                malloc((EV)->genome_size);    \
+  } while (0)
 
 /**
- * Macro for sorting the Evolution by fittnes 
- * using Macro based version onely because
- * parallel version will propably need more then
- * 16 Corse to be efficient
+ * Clones the genome SRC into DST (with memcpy for pod genomes)
+ */
+#define EV_CLONE_IV(EV, DST, SRC, OPT)                        \
+  do {                                                        \
+    if ((EV)->pod_genome)                                     \
+      memcpy(DST, SRC, (EV)->genome_size);                    \
+    else                                                      \
+      (EV)->clone_iv(DST, SRC, OPT);                          \
+  } while (0)
+
+/**
+ * Frees the given genome (with free for pod genomes)
+ */
+#define EV_FREE_IV(EV, IV, OPT)                               \
+  do {                                                        \
+    if ((EV)->pod_genome)                                     \
+      free(IV);                                               \
+    else                                                      \
+      (EV)->free_iv(IV, OPT);                                 \
+  } while (0)
+
+/**
+ * Frees a genome returned by an Evolution 
+ * with the given args (see EV_FREE_IV)
+ */
+#define EV_ARGS_FREE_IV(ARGS, IV, OPT)                        \
+  do {                                                        \
+    if ((ARGS)->flags & EV_PODG)                              \
+      free(IV);                                               \
+    else                                                      \
+      (ARGS)->free_iv(IV, OPT);                               \
+  } while (0)
+
+/**
+ * Replaces the individual at the given possition by a new random one
+ * (in place with reinit_iv if there is one)
  */
-#define EV_SELECTION(EV)                                      \
+#define EV_RENEW_IV(EV, I, OPT)                               \
   do {                                                        \
-    if ((EV)->sort_max) {                                     \
-      QUICK_INSERT_SORT_MAX(Individual *,                     \
-                            (EV)->population,                 \
-                            (EV)->population_size,            \
-                            ev_bigger,                        \
-                            ev_smaler,                        \
-                            ev_equal,                         \
-                            (EV)->min_quicksort);             \
+    if ((EV)->reinit_iv != NULL) {                            \
+      (EV)->reinit_iv((EV)->population[I]->iv, OPT);          \
     } else {                                                  \
-      QUICK_INSERT_SORT_MIN(Individual *,                     \
-                            (EV)->population,                 \
-                            (EV)->population_size,            \
-                            ev_bigger,                        \
-                            ev_smaler,                        \
-                            ev_equal,                         \
-                            (EV)->min_quicksort);             \
+      EV_FREE_IV(EV, (EV)->population[I]->iv, OPT);           \
+      (EV)->population[I]->iv = (EV)->init_iv(OPT);           \
     }                                                         \
   } while (0)
 
-/* macro to copy one individual to an other if it is better */
-#define EV_COPY_GREEDY(EV, ID_DST, ID_SRC, OPTS)                  \
-do {                                                              \
-  if ((EV)->sort_max) {                                           \
-    if (EV_FITNESS_AT(EV, ID_DST) < EV_FITNESS_AT(EV, ID_SRC)) {  \
-      (EV)->clone_iv((EV)->population[ID_DST]->iv,                \
-                     (EV)->population[ID_SRC]->iv,                \
-                     OPTS);                                       \
+/**
+ * The patch of the individual with the given index in ivs (delta mode)
+ */
+#define EV_DELTA_AT(EV, K)                                    \
+  ((void *) ((EV)->deltas + (size_t) (K) * (EV)->delta_size))
+
+/**
+ * The undo buffer of the thread with the given index (undo mode)
+ */
+#define EV_UNDO_AT(EV, T)                                     \
+  ((void *) ((EV)->undo_logs + (size_t) (T) * (EV)->undo_size))
+
+/**
+ * The genome of the individual at the given possition in arena mode
+ */
+#define EV_ARENA_GENOME(EV, I)                                \
+  ((void *) ((EV)->arena[(I) / (EV)->arena_ivs] +             \
+             (size_t) ((I) % (EV)->arena_ivs) *               \
+             (EV)->genome_stride))
+
+/**
+ * Creates a new individual for the given possition
+ * (inside its slab in arena mode)
+ */
+#define EV_NEW_IV(EV, I, OPT)                                 \
+  ((EV)->arena != NULL ? ev_arena_init_at(EV, I, OPT) :       \
+                         (EV)->init_iv(OPT))
+
+/**
+ * Returns wether fitness A is better than fitness B
+ * with respect to the sorting order of the given Evolution
+ */
+#define EV_BETTER(EV, A, B) ((EV)->sort_max ? (A) > (B) : (A) < (B))
+
+/**
+ * Calculates the fittnes of the individual
+ * at the given possition in the given Evolution
+ * with the given opts
+ */
+#define EV_CALC_FITNESS_AT(EV, I, OPTS)                                       \
+  (EV)->population[I]->fitness = (EV)->fitness((EV)->population[I], OPTS)
+
+/**
+ * Macro for sorting the Evolution by fittnes 
+ * using Macro based version onely because
+ * parallel version will propably need more then
+ * 16 Corse to be efficient
+ */
+#define EV_SELECTION(EV) EV_SELECTION_AT(EV, 0, (EV)->population_size)
+
+/**
+ * Sorts the whole population, with the radix sort for big 
+ * populations (on all threads if PARALLEL is set and the 
+ * threads are idle)
+ */
+#define EV_SORT(EV, PARALLEL)                                 \
+  do {                                                        \
+    if ((EV)->population_size >= (EV)->min_radix)             \
+      ev_radix_sort(EV, PARALLEL);                            \
+    else                                                      \
+      EV_SELECTION(EV);                                       \
+  } while (0)
+
+/**
+ * If the parent selection of the given Evolution 
+ * dosn't need a sorted population
+ */
+#define EV_SORT_FREE(EV)                                      \
+  ((EV)->parent_selection == EV_PARENT_TOURNAMENT ||          \
+   (EV)->parent_selection == EV_PARENT_PROPORTIONAL)
+
+/**
+ * The fitness as an unsigned key wich is in sort order
+ * (sign bit flipped, all bits flipped for EV_SORT_MAX)
+ */
+#define EV_FITNESS_KEY(EV, F)                                   \
+  ((EV)->sort_max ? ~((uint64_t) (F) ^ (1ULL << 63)) :        \
+                    ((uint64_t) (F) ^ (1ULL << 63)))
+
+/**
+ * The phases of the radix sort
+ */
+#define EV_RADIX_FILL    0
+#define EV_RADIX_COUNT   1
+#define EV_RADIX_SCATTER 2
+#define EV_RADIX_COPY    3
+
+/**
+ * Sorts LEN individuals of the population starting at START
+ * (used by the island model to sort one island)
+ */
+#define EV_SELECTION_AT(EV, START, LEN)                       \
+  do {                                                        \
+    ev_keys_fill(EV, START, LEN);                             \
+    EV_KEY_SORT_AT(EV, START, LEN);                           \
+    ev_keys_store(EV, START, LEN);                            \
+  } while (0)
+
+/**
+ * Sorts the keys [START, START + LEN) (wich are in sort order
+ * for EV_SORT_MAX too)
+ */
+#define EV_KEY_SORT_AT(EV, START, LEN)                        \
+  QUICK_INSERT_SORT_MIN(EvKey,                                \
+                        (EV)->keys + (START),                 \
+                        (LEN),                                \
+                        ev_key_bigger,                        \
+                        ev_key_smaler,                        \
+                        ev_key_equal,                         \
+                        (EV)->min_quicksort)
+
+/* macro to copy one individual to an other if it is better */
+#define EV_COPY_GREEDY(EV, ID_DST, ID_SRC, OPTS)                  \
+do {                                                              \
+  if ((EV)->sort_max) {                                           \
+    if (EV_FITNESS_AT(EV, ID_DST) < EV_FITNESS_AT(EV, ID_SRC)) {  \
+      EV_CLONE_IV(EV, (EV)->population[ID_DST]->iv,               \
+                      (EV)->population[ID_SRC]->iv,               \
+                      OPTS);                                      \
                                                                   \
       EV_FITNESS_AT(EV, ID_DST) = EV_FITNESS_AT(EV, ID_SRC);      \
     }                                                             \
   } else {                                                        \
     if (EV_FITNESS_AT(EV, ID_DST) > EV_FITNESS_AT(EV, ID_SRC)) {  \
-      (EV)->clone_iv((EV)->population[ID_DST]->iv,                \
-                     (EV)->population[ID_SRC]->iv,                \
-                     OPTS);                                       \
+      EV_CLONE_IV(EV, (EV)->population[ID_DST]->iv,               \
+                      (EV)->population[ID_SRC]->iv,               \
+                      OPTS);                                      \
                                                                   \
       EV_FITNESS_AT(EV, ID_DST) = EV_FITNESS_AT(EV, ID_SRC);      \
     }                                                             \
@@ -252,18 +893,18 @@ do {                                                              \
 do {                                                              \
   if ((EV)->sort_max) {                                           \
     if (EV_FITNESS_AT(EV, ID_DST) < EV_FITNESS_AT(EV, ID_SRC)) {  \
-      (EV)->clone_iv((EV)->population[ID_DST]->iv,                \
-                     (EV)->population[ID_SRC]->iv,                \
-                     OPTS);                                       \
+      EV_CLONE_IV(EV, (EV)->population[ID_DST]->iv,               \
+                      (EV)->population[ID_SRC]->iv,               \
+                      OPTS);                                      \
                                                                   \
       EV_FITNESS_AT(EV, ID_DST) = EV_FITNESS_AT(EV, ID_SRC);      \
       (COUNT)++;                                                  \
     }                                                             \
   } else {                                                        \
     if (EV_FITNESS_AT(EV, ID_DST) > EV_FITNESS_AT(EV, ID_SRC)) {  \
-      (EV)->clone_iv((EV)->population[ID_DST]->iv,                \
-                     (EV)->population[ID_SRC]->iv,                \
-                     OPTS);                                       \
+      EV_CLONE_IV(EV, (EV)->population[ID_DST]->iv,               \
+                      (EV)->population[ID_SRC]->iv,               \
+                      OPTS);                                      \
                                                                   \
       EV_FITNESS_AT(EV, ID_DST) = EV_FITNESS_AT(EV, ID_SRC);      \
       (COUNT)++;                                                  \
@@ -276,11 +917,11 @@ do {                                                              \
  * Prints status information during 
  * threadable init individuals 
  */
-#define EV_INIT_IV_OUTPUT(INDEX)                                              \
+#define EV_INIT_IV_OUTPUT(EV, INDEX)                                          \
   do {                                                                        \
-    pthread_mutex_lock(&ev_mutex);                                            \
+    pthread_mutex_lock(&(EV).mutex);                                          \
     printf("init population: %10d\r", INDEX);                                 \
-    pthread_mutex_unlock(&ev_mutex);                                          \
+    pthread_mutex_unlock(&(EV).mutex);                                        \
   } while (0)
 
 /**
@@ -289,13 +930,13 @@ do {                                                              \
  */
 #define EV_IV_STATUS_OUTPUT(EV, INDEX)                                        \
   do {                                                                        \
-      pthread_mutex_lock(&ev_mutex);                                          \
+      pthread_mutex_lock(&(EV).mutex);                                        \
       printf("Evolution: generation left %10d "                               \
              "tasks mutation-1/x %10d improovs %15.5f%%\r",                   \
              (EV).generation_limit - (EV).info.generations_progressed,        \
              (EV).overall_end - INDEX,                                        \
              (((EV).info.improovs / (double) (EV).deaths) * 100.0));          \
-      pthread_mutex_unlock(&ev_mutex);                                        \
+      pthread_mutex_unlock(&(EV).mutex);                                      \
   } while (0)
 
 /**
@@ -304,13 +945,13 @@ do {                                                              \
  */
 #define EV_IV_GREEDY_STATUS_OUTPUT(EV, INDEX)                                 \
   do {                                                                        \
-      pthread_mutex_lock(&ev_mutex);                                          \
+      pthread_mutex_lock(&(EV).mutex);                                        \
       printf("Evolution: generation left %10d "                               \
              "tasks greedy %10d improovs %10.d\r",                            \
              (EV).generation_limit - (EV).info.generations_progressed,        \
              (EV).greedy_size - INDEX,                                        \
              (EV).info.improovs);                                             \
-      pthread_mutex_unlock(&ev_mutex);                                        \
+      pthread_mutex_unlock(&(EV).mutex);                                      \
   } while (0)
 
 #define ANSI_COLOR_RED     "\x1b[31m"
@@ -374,11 +1015,11 @@ do {                                                                          \
   }                                                                           \
 } while (0)
 
-#define EV_THREAD_SAVE_NEW_LINE                                               \
+#define EV_THREAD_SAVE_NEW_LINE(EV)                                           \
   do {                                                                        \
-    pthread_mutex_lock(&ev_mutex);                                            \
+    pthread_mutex_lock(&(EV).mutex);                                          \
     printf("\n");                                                             \
-    pthread_mutex_unlock(&ev_mutex);                                          \
+    pthread_mutex_unlock(&(EV).mutex);                                        \
   } while (0)
     
 
@@ -401,7 +1042,29 @@ do {                                                                          \
                                          Individual *,                        \
                                          Individual *,                        \
                                          void *))                  &(X) = (Y)
+#define INIT_C_SUBMIT(X, Y)  *(void (**)(Individual *, void *))    &(X) = (Y)
+#define INIT_C_COMPLT(X, Y)  *(Individual *(**)(char, void *))     &(X) = (Y)
 #define INIT_C_CONTINU(X, Y) *(char (**)(Evolution *const))        &(X) = (Y)
+#define INIT_C_SERIALZ(X, Y) *(size_t (**)(void *,                            \
+                                           size_t,                            \
+                                           void *,                            \
+                                           void *))                &(X) = (Y)
+#define INIT_C_DESERLZ(X, Y) *(void (**)(void *,                              \
+                                         const void *,                        \
+                                         size_t,                              \
+                                         void *))                  &(X) = (Y)
+#define INIT_C_INIT_AT(X, Y) *(void (**)(void *, void *))          &(X) = (Y)
+#define INIT_C_REINIT(X, Y)  *(void (**)(void *, void *))          &(X) = (Y)
+#define INIT_C_MUT_DLT(X, Y) *(void (**)(Individual *,                        \
+                                         void *,                              \
+                                         void *))                  &(X) = (Y)
+#define INIT_C_FIT_DLT(X, Y) *(int64_t (**)(Individual *,                     \
+                                            void *,                           \
+                                            void *))               &(X) = (Y)
+#define INIT_C_APP_DLT(X, Y) *(void (**)(void *, void *, void *))  &(X) = (Y)
+#define INIT_C_UNDO(X, Y)    *(void (**)(Individual *,                        \
+                                         void *,                              \
+                                         void *))                  &(X) = (Y)
 #define INIT_C_EVTARGS(X, Y) *(EvThreadArgs ***)                   &(X) = (Y)
 #define INIT_C_ETA(X, Y)     *(EvThreadArgs **)                    &(X) = (Y)
 #define INIT_C_INT(X, Y)     *(int *)                              &(X) = (Y)
@@ -410,9 +1073,13 @@ do {                                                                          \
 #define INIT_C_TCS(X, Y)     *(TClient **)                         &(X) = (Y)
 #define INIT_C_CHR(X, Y)     *(char *)                             &(X) = (Y)
 #define INIT_C_U64(X, Y)     *(uint64_t *)                         &(X) = (Y)
+#define INIT_C_U32(X, Y)     *(uint32_t *)                         &(X) = (Y)
+#define INIT_C_POOL(X, Y)    *(EvPool **)                          &(X) = (Y)
 #define INIT_C_U16(X, Y)     *(uint16_t *)                         &(X) = (Y)
 #define INIT_C_EVO(X, Y)     *(Evolution **)                       &(X) = (Y)
 #define INIT_C_VPT(X, Y)     *(void **)                            &(X) = (Y)
+#define INIT_C_IPT(X, Y)     *(int **)                             &(X) = (Y)
+#define INIT_C_SIZ(X, Y)     *(size_t *)                           &(X) = (Y)
 
 /**
  * Returns pointer to an new and initialzed Evolution
@@ -426,6 +1093,18 @@ Evolution *new_evolution(EvInitArgs *args) {
   if (!valid_args(args))
     return NULL;
 
+  /* in process mode the migrants are exchanged over shared memory */
+  size_t shm_size = 0;
+  void *shm       = NULL;
+  if (args->flags & EV_PROC) {
+    shm = ev_shm_open(args, &shm_size);
+
+    if (shm == NULL) {
+      DBG_MSG("wrong opts");
+      return NULL;
+    }
+  }
+
   /* in greedy mode we have on greedy best individual
    * one generation best and one temporary individual */
   if (args->flags & EV_GRDY)
@@ -435,10 +1114,11 @@ Evolution *new_evolution(EvInitArgs *args) {
   Evolution *ev = (Evolution *) malloc(sizeof(Evolution));
 
   /* int random */
+  uint32_t instance = __atomic_fetch_add(&ev_instances, 1, __ATOMIC_RELAXED);
   ev->rands = (rand128_t **) malloc(sizeof(rand128_t *) * args->num_threads);
   int i;
   for (i = 0; i < args->num_threads; i++)
-    ev->rands[i] = new_rand128(time(NULL) ^ i);
+    ev->rands[i] = new_rand128(time(NULL) ^ i ^ (instance << 16));
 
   /**
    * multiplicator: if we should discard the last generation, 
@@ -452,10 +1132,44 @@ Evolution *new_evolution(EvInitArgs *args) {
 
   population_space         *= args->population_size * mul;
   ivs_space                *= args->population_size * mul;
+
+  /* in steady state mode each thread has one private offspring */
+  if (args->flags & EV_STST)
+    ivs_space              += sizeof(Individual) * args->num_threads;
   
+
+  ev->population_space     = population_space;
+  ev->ivs_space            = ivs_space;
+  INIT_C_IPT(ev->cpus,       ev_thread_cpus(args));
                            
-  ev->population           = (Individual **) malloc(population_space);
-  ev->ivs                  = (Individual *) malloc(ivs_space);
+  /**
+   * pinned threads first touch the slices they initialize,
+   * so the pages have to be untouched
+   */
+  if (ev->cpus != NULL) {
+    ev->population         = (Individual **) mmap(NULL, 
+                                                  population_space, 
+                                                  PROT_READ | PROT_WRITE,
+                                                  MAP_PRIVATE | 
+                                                  MAP_ANONYMOUS, 
+                                                  -1, 
+                                                  0);
+    ev->ivs                = (Individual *) mmap(NULL, 
+                                                 ivs_space, 
+                                                 PROT_READ | PROT_WRITE,
+                                                 MAP_PRIVATE | 
+                                                 MAP_ANONYMOUS, 
+                                                 -1, 
+                                                 0);
+
+    if (ev->population == MAP_FAILED || ev->ivs == MAP_FAILED) {
+      perror("mmap");
+      abort();
+    }
+  } else {
+    ev->population         = (Individual **) malloc(population_space);
+    ev->ivs                = (Individual *) malloc(ivs_space);
+  }
 
   INIT_C_INIT_IV(ev->init_iv,     args->init_iv);
   INIT_C_CLON_IV(ev->clone_iv,    args->clone_iv);
@@ -466,10 +1180,14 @@ Evolution *new_evolution(EvInitArgs *args) {
   INIT_C_CONTINU(ev->continue_ev, args->continue_ev);
 
   /* only needed if we have more than one thread */
+  ev->pthreads = NULL;
   if (args->num_threads > 1) {
     INIT_C_TCS(ev->thread_clients,  malloc(sizeof(TClient) * 
                                            args->num_threads));
 
+    ev->pthreads = (pthread_t *) malloc(sizeof(pthread_t) * 
+                                        args->num_threads);
+
     INIT_C_EVTARGS(ev->thread_args, malloc(sizeof(EvThreadArgs *) *
                                            args->num_threads));
   }
@@ -492,18 +1210,222 @@ Evolution *new_evolution(EvInitArgs *args) {
   INIT_C_CHR(ev->keep_last_generation,  args->flags & EV_KEEP);
   INIT_C_CHR(ev->use_abort_requirement, args->flags & EV_ABRT);
   INIT_C_CHR(ev->use_greedy,            args->flags & EV_GRDY);
+  INIT_C_CHR(ev->greedy_async,          (args->flags & EV_GASY) != 0);
+  INIT_C_CHR(ev->async_fitness,         (args->flags & EV_AFIT) != 0);
+
+  /* the async fitness args are only set with EV_AFIT */
+  if (ev->async_fitness) {
+    INIT_C_SUBMIT(ev->submit_fitness,   args->submit_fitness);
+    INIT_C_COMPLT(ev->complete_fitness, args->complete_fitness);
+    INIT_C_INT(ev->max_in_flight,       args->max_in_flight);
+  } else {
+    INIT_C_SUBMIT(ev->submit_fitness,   NULL);
+    INIT_C_COMPLT(ev->complete_fitness, NULL);
+    INIT_C_INT(ev->max_in_flight,       0);
+  }
+  INIT_C_CHR(ev->lazy_init,             (args->flags & EV_LAZY) != 0);
+
+  /* the alloc function is only set with EV_LAZY */
+  if (args->flags & EV_LAZY) {
+    INIT_C_INIT_IV(ev->alloc_iv,        args->alloc_iv);
+  } else {
+    INIT_C_INIT_IV(ev->alloc_iv,        NULL);
+  }
+
+  /* the reinit function is only set with EV_RINI */
+  if (args->flags & EV_RINI) {
+    INIT_C_REINIT(ev->reinit_iv,        args->reinit_iv);
+  } else {
+    INIT_C_REINIT(ev->reinit_iv,        NULL);
+  }
+
+  INIT_C_CHR(ev->use_undo,              (args->flags & EV_UNDO) != 0);
+
+  /* the undo functions are only set with EV_UNDO */
+  if (ev->use_undo) {
+    INIT_C_UNDO(ev->mutate_undoable,    args->mutate_undoable);
+    INIT_C_UNDO(ev->undo,               args->undo);
+    INIT_C_SIZ(ev->undo_size,           args->undo_size);
+  } else {
+    INIT_C_UNDO(ev->mutate_undoable,    NULL);
+    INIT_C_UNDO(ev->undo,               NULL);
+    INIT_C_SIZ(ev->undo_size,           0);
+  }
+
+  INIT_C_CHR(ev->use_delta,             (args->flags & EV_DLTA) != 0);
+
+  /* the delta functions are only set with EV_DLTA */
+  if (ev->use_delta) {
+    INIT_C_MUT_DLT(ev->mutate_delta,    args->mutate_delta);
+    INIT_C_FIT_DLT(ev->fitness_delta,   args->fitness_delta);
+    INIT_C_APP_DLT(ev->apply_delta,     args->apply_delta);
+    INIT_C_SIZ(ev->delta_size,          args->delta_size);
+  } else {
+    INIT_C_MUT_DLT(ev->mutate_delta,    NULL);
+    INIT_C_FIT_DLT(ev->fitness_delta,   NULL);
+    INIT_C_APP_DLT(ev->apply_delta,     NULL);
+    INIT_C_SIZ(ev->delta_size,          0);
+  }
+
+  INIT_C_CHR(ev->use_arena,             (args->flags & EV_ARENA) != 0);
+  INIT_C_CHR(ev->pod_genome,            (args->flags & EV_PODG) != 0);
+
+  /* the genome args are only set with EV_ARENA or EV_PODG */
+  if (ev->use_arena || ev->pod_genome) {
+    INIT_C_SIZ(ev->genome_size,         args->genome_size);
+    INIT_C_SIZ(ev->genome_stride,       (args->genome_size + 
+                                         EV_GENOME_ALIGN - 1) & 
+                                        ~(size_t) (EV_GENOME_ALIGN - 1));
+  } else {
+    INIT_C_SIZ(ev->genome_size,         0);
+    INIT_C_SIZ(ev->genome_stride,       0);
+  }
+
+  if (ev->use_arena) {
+    INIT_C_INIT_AT(ev->init_iv_at,      args->init_iv_at);
+  } else {
+    INIT_C_INIT_AT(ev->init_iv_at,      NULL);
+  }
+
+  /* the slabs are allocated during the init of the population */
+  ev->arena                             = NULL;
+  ev->arena_slabs                       = 0;
+  ev->arena_ivs                         = 0;
+  INIT_C_CHR(ev->steady_state,          (args->flags & EV_STST) != 0);
+  INIT_C_CHR(ev->use_islands,           (args->flags & EV_ISLE) != 0);
+
+  INIT_C_CHR(ev->use_processes,         (args->flags & EV_PROC) != 0);
+
+  /* the migration args are only set in island or process mode */
+  if (ev->use_islands || ev->use_processes) {
+    INIT_C_INT(ev->migration_interval,  args->migration_interval);
+    INIT_C_INT(ev->migration_size,      args->migration_size);
+  } else {
+    INIT_C_INT(ev->migration_interval,  0);
+    INIT_C_INT(ev->migration_size,      0);
+  }
+
+  /* processes allways migrate in a ring */
+  if (ev->use_islands) {
+    INIT_C_INT(ev->migration_topology,  args->migration_topology);
+  } else {
+    INIT_C_INT(ev->migration_topology,  EV_MIGRATE_RING);
+  }
+  ev->island_generations                = 0;
+
+  if (ev->use_processes) {
+    INIT_C_SERIALZ(ev->serialize_iv,    args->serialize_iv);
+    INIT_C_DESERLZ(ev->deserialize_iv,  args->deserialize_iv);
+    INIT_C_INT(ev->process_index,       args->process_index);
+    INIT_C_INT(ev->num_processes,       EV_SHM_HEADER(shm)->num_processes);
+  } else {
+    INIT_C_SERIALZ(ev->serialize_iv,    NULL);
+    INIT_C_DESERLZ(ev->deserialize_iv,  NULL);
+    INIT_C_INT(ev->process_index,       0);
+    INIT_C_INT(ev->num_processes,       1);
+  }
+  ev->shm                               = shm;
+  ev->shm_size                          = shm_size;
+
+  INIT_C_CHR(ev->partial_selection,     (args->flags & EV_PSEL) != 0);
+  INIT_C_CHR(ev->merge_selection,       (args->flags & EV_MSEL) != 0);
+  INIT_C_U32(ev->parent_selection,      args->flags & EV_PARENT_MASK);
+
+  /* the tournament size is only set with EV_PTRN */
+  if (ev->parent_selection == EV_PARENT_TOURNAMENT) {
+    INIT_C_INT(ev->tournament_size,     args->tournament_size);
+  } else {
+    INIT_C_INT(ev->tournament_size,     0);
+  }
+  INIT_C_U32(ev->executor,              args->flags & EV_EXECUTOR_MASK);
+  pthread_mutex_init(&ev->mutex, NULL);
+  pthread_mutex_init(&ev->greedy_lock, NULL);
+
+  /* the pool is only used by the shared executor */
+  if (ev->executor == EV_EXECUTOR_SHARED && ev->num_threads > 1) {
+    INIT_C_POOL(ev->pool,               args->pool);
+    ev->pool_next                       = 0;
+    ev->pool_remaining                  = 0;
+    pthread_cond_init(&ev->pool_done, NULL);
+    ev_pool_add(ev->pool, ev);
+  } else {
+    INIT_C_POOL(ev->pool,               NULL);
+  }
+  ev->bar_spin                          = EV_SPIN_MIN;
+  ev->bar_stop                          = 0;
+  ev->info.barrier_wait_ns              = 0;
+  ev->async                             = NULL;
+
+  /* the dense fitness keys for the selection */
+  ev->keys = (EvKey *) malloc(sizeof(EvKey) * ev->population_size);
+
+  /* one undo buffer for each thread */
+  ev->undo_logs = NULL;
+  if (ev->use_undo)
+    ev->undo_logs = (char *) malloc(ev->undo_size * ev->num_threads);
+
+  /* one patch and parent for each individual (none pending) */
+  ev->deltas        = NULL;
+  ev->delta_parents = NULL;
+  if (ev->use_delta) {
+    ev->deltas        = (char *) malloc(ev->delta_size * 
+                                        ev->population_size);
+    ev->delta_parents = (Individual **) calloc(ev->population_size, 
+                                               sizeof(Individual *));
+  }
+
+  /* the alias table over the parents */
+  ev->alias_prob    = NULL;
+  ev->alias_index   = NULL;
+  ev->alias_weights = NULL;
+  ev->alias_work    = NULL;
+  if (ev->parent_selection == EV_PARENT_PROPORTIONAL ||
+      ev->parent_selection == EV_PARENT_RANK) {
+    ev->alias_prob    = (uint32_t *) malloc(sizeof(uint32_t) * 
+                                            ev->population_size);
+    ev->alias_index   = (int *) malloc(sizeof(int) * ev->population_size);
+    ev->alias_weights = (double *) malloc(sizeof(double) * 
+                                          ev->population_size);
+    ev->alias_work    = (int *) malloc(sizeof(int) * ev->population_size);
+  }
+
+  /* the survivors and one run per thread */
+  ev->merged     = NULL;
+  ev->merge_runs = NULL;
+  if (ev->merge_selection) {
+    ev->merged     = (Individual **) malloc(sizeof(Individual *) * 
+                                            ev->population_size);
+    ev->merge_runs = (int *) malloc(sizeof(int) * (ev->num_threads + 2));
+  }
   INIT_C_CHR(ev->sort_max,              args->flags & EV_SMAX);
   INIT_C_U16(ev->verbose,               args->flags & (EV_VEB1 |
                                                        EV_VEB2 |
                                                        EV_VEB3));
 
-  INIT_C_INT(ev->min_quicksort,         EV_QICKSORT_MIN);
+  /* the tuned values are only set with EV_TUNE */
+  if (args->flags & EV_TUNE) {
+    INIT_C_INT(ev->min_quicksort,       args->min_quicksort);
+    INIT_C_INT(ev->chunks_per_thread,   args->chunks_per_thread);
+    INIT_C_INT(ev->min_radix,           args->min_radix);
+  } else {
+    INIT_C_INT(ev->min_quicksort,       EV_QICKSORT_MIN);
+    INIT_C_INT(ev->chunks_per_thread,   EV_CHUNKS_PER_THREAD);
+    INIT_C_INT(ev->min_radix,           EV_RADIX_MIN);
+  }
+
+  /* the radix buffers are allocated on first use */
+  ev->radix_src                         = NULL;
+  ev->radix_dst                         = NULL;
+  ev->radix_counts                      = NULL;
+  ev->chunk_size                        = 1;
   INIT_C_INT(ev->deaths,                (int) ((double) ev->population_size * 
                                                ev->death_percentage));
   INIT_C_INT(ev->survivors,             ev->population_size - ev->deaths);
 
   ev->info.improovs                     = 0;
   ev->info.generations_progressed       = 0;
+  ev->scratch                           = NULL;
+  ev->iv_locks                          = NULL;
 
   /**
    * Initializes Thread Clients and Individuals
@@ -515,6 +1437,9 @@ Evolution *new_evolution(EvInitArgs *args) {
   else
     ev_init_tc_and_ivs_serial(ev);
 
+  if (ev->steady_state)
+    ev_init_steady_state_ivs(ev);
+
   return ev;
 }
 
@@ -528,8 +1453,10 @@ static void ev_init_tc_and_ivs(Evolution *ev) {
    * max work will be death_percentage * num individuals
    */
   int i;
-  for (i = 0; i < ev->num_threads; i++)
-    init_thread_client(&ev->thread_clients[i]);
+  if (ev->executor == EV_EXECUTOR_TCLIENT) {
+    for (i = 0; i < ev->num_threads; i++)
+      init_thread_client(&ev->thread_clients[i]);
+  }
 
   /**
    * multiplicator: if we should discard the last generation, 
@@ -542,10 +1469,21 @@ static void ev_init_tc_and_ivs(Evolution *ev) {
   ev->overall_start = 0;
   ev->overall_end   = ev->population_size * mul;
 
+  /**
+   * in lazy mode only the parents of the first generation are 
+   * initialized now, the others are created on first use
+   */
+  int init_end = ev->overall_end;
+  if (ev->lazy_init) {
+    init_end = ev->keep_last_generation ? ev->survivors : 
+                                          ev->population_size;
+    ev_init_lazy_ivs(ev, init_end);
+  }
+
   /**
    * number of individuals calculated by one thread
    */
-  uint32_t ivs_per_thread = (ev->overall_end - ev->overall_start) /
+  uint32_t ivs_per_thread = (init_end - ev->overall_start) /
                             ev->num_threads + 1;
 
   /* in greedy mode we have on greedy best individual
@@ -553,44 +1491,83 @@ static void ev_init_tc_and_ivs(Evolution *ev) {
   if (ev->use_greedy)
     ivs_per_thread = 3;
 
+  /* one slab per thread slice, allocated by the thread itself */
+  if (ev->use_arena) {
+    ev->arena_slabs = ev->num_threads;
+    ev->arena_ivs   = ivs_per_thread;
+    ev->arena       = (char **) calloc(ev->num_threads, sizeof(char *));
+  }
+
   /* add work for the clients */
   for (i = 0; i < ev->num_threads; i++) {
 
-    /* init thread args */
-    INIT_C_ETA(ev->thread_args[i], malloc(sizeof(EvThreadArgs)));
+    /* init thread args (an own page for pinned threads) */
+    if (ev->cpus != NULL) {
+      void *page;
+      if (posix_memalign(&page, 
+                         sysconf(_SC_PAGESIZE), 
+                         sysconf(_SC_PAGESIZE)) != 0)
+        page = malloc(sizeof(EvThreadArgs));
+
+      INIT_C_ETA(ev->thread_args[i], page);
+    } else
+      INIT_C_ETA(ev->thread_args[i], malloc(sizeof(EvThreadArgs)));
+
     INIT_C_EVO(ev->thread_args[i]->ev,    ev);
     INIT_C_INT(ev->thread_args[i]->index, i);
     INIT_C_VPT(ev->thread_args[i]->opt,   ev->opts[i]);
     ev->thread_args[i]->improovs = 0;
+    ev->thread_args[i]->func     = NULL;
+    ev->thread_args[i]->spin     = EV_SPIN_MIN;
+    ev->thread_args[i]->cpu      = ev->cpus != NULL ? ev->cpus[i] : -1;
+    ev->thread_args[i]->pinned   = 0;
+    ev->thread_args[i]->num_in_flight = 0;
+    ev->thread_args[i]->in_flight     = NULL;
+
+    if (ev->async_fitness)
+      ev->thread_args[i]->in_flight = (EvInFlight *) malloc(
+                                        sizeof(EvInFlight) * 
+                                        ev->max_in_flight);
+    ev->thread_args[i]->start_ns = ev->thread_args[i]->finish_ns = 0;
+    pthread_mutex_init(&ev->thread_args[i]->lock, NULL);
 
     /* set working area of thread i */
     ev->thread_args[i]->start = ev->overall_start + i * ivs_per_thread;
     ev->thread_args[i]->end   = ev->thread_args[i]->start + ivs_per_thread;
 
-    if (ev->thread_args[i]->end > ev->overall_end)
-      ev->thread_args[i]->end = ev->overall_end;
+    if (ev->thread_args[i]->end > init_end)
+      ev->thread_args[i]->end = init_end;
 
-    if (ev->thread_args[i]->start > ev->overall_end)
-      ev->thread_args[i]->start = ev->overall_end;
+    if (ev->thread_args[i]->start > init_end)
+      ev->thread_args[i]->start = init_end;
 
-    tc_add_func(&ev->thread_clients[i], 
-                (ev->use_greedy ? threadable_greedy_init_iv : 
-                                  threadable_init_iv), 
-                (void *) ev->thread_args[i]);
+    ev_set_thread_func(ev, 
+                       i, 
+                       (ev->use_greedy ? threadable_greedy_init_iv : 
+                                         threadable_init_iv));
   }
 
-  /* wait for threads and collect improovs */
-  for (i = 0; i < ev->num_threads; i++) {
-    tc_join(&ev->thread_clients[i]);
+  /* the pool threads are running untill the clean up */
+  if (ev->executor == EV_EXECUTOR_POOL)
+    ev_start_barrier(ev);
+
+  ev_start_threads(ev);
+  ev_wait_threads(ev);
+
+  /* collect improovs */
+  for (i = 0; i < ev->num_threads; i++)
     ev->info.improovs += ev->thread_args[i]->improovs;
-  }
 
   /**
    * Select the best individual to survive,
    * Sort the Individuals by their fittnes
    */
-  if (!ev->use_greedy)
-    EV_SELECTION(ev); 
+  if (ev->lazy_init)
+    EV_SELECTION_AT(ev, 0, init_end);
+  else if (ev->partial_selection)
+    ev_partition(ev, ev->survivors);
+  else if (!ev->use_greedy)
+    EV_SORT(ev, ev->num_threads > 1); 
 
   if (ev->verbose >= EV_VERBOSE_HIGH)
     printf("Population Initialized\n");
@@ -617,6 +1594,14 @@ static void ev_init_tc_and_ivs(Evolution *ev) {
 #undef INIT_C_U16
 #undef INIT_C_EVO
 #undef INIT_C_VPT
+#undef INIT_C_IPT
+#undef INIT_C_INIT_AT
+#undef INIT_C_REINIT
+#undef INIT_C_MUT_DLT
+#undef INIT_C_FIT_DLT
+#undef INIT_C_APP_DLT
+#undef INIT_C_UNDO
+#undef INIT_C_SIZ
 
 /**
  * Returns wether the given EvInitArgs are valid or not
@@ -649,6 +1634,162 @@ static char valid_args(EvInitArgs *args) {
     return 0;
   }
 
+  /* steady state replaces an individual other than the best */
+  if (args->flags & EV_STST && args->population_size < 2) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /**
+   * each island needs enough survivors to select parents
+   * and to send elites, and enough deaths to receive migrants
+   * (the size of an island is population_size / num_threads or one more)
+   */
+  if (args->flags & EV_ISLE) {
+    int island_size      = args->population_size / args->num_threads;
+    int island_deaths    = (int) ((double) island_size * 
+                                  args->death_percentage);
+    int island_survivors = island_size - island_deaths;
+
+    if (args->num_threads        <  2                                 ||
+        args->migration_interval <  1                                 ||
+        args->migration_size     <  0                                 ||
+        args->migration_size     >  island_deaths                     ||
+        args->migration_size     >  island_survivors                  ||
+        island_survivors         < ((args->flags & EV_UREC) ? 2 : 1)  ||
+        args->migration_topology <  EV_MIGRATE_RING                   ||
+        args->migration_topology >  EV_MIGRATE_FULL) {
+
+      DBG_MSG("wrong opts");
+      return 0;
+    }
+  }
+
+  /**
+   * the migrants replace the worst new individuals
+   * and are taken from the best individuals
+   */
+  if (args->flags & EV_PROC) {
+    int deaths    = (int) ((double) args->population_size * 
+                           args->death_percentage);
+    int survivors = args->population_size - deaths;
+
+    if (args->migration_interval <  1         ||
+        args->migration_size     <  0         ||
+        args->migration_size     >  deaths    ||
+        args->migration_size     >  survivors ||
+        args->process_index      <  0         ||
+        args->shm_name           == NULL      ||
+        args->serialize_iv       == NULL      ||
+        args->deserialize_iv     == NULL) {
+
+      DBG_MSG("wrong opts");
+      return 0;
+    }
+  }
+
+  /* the shared executor needs a pool */
+  if ((args->flags & EV_EXECUTOR_MASK) == EV_EXECUTOR_SHARED && 
+      args->pool == NULL) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* async fitness needs both callbacks */
+  if (args->flags & EV_AFIT && (
+      args->submit_fitness   == NULL ||
+      args->complete_fitness == NULL ||
+      args->max_in_flight    <  1)) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* the arena needs the size of the genomes to place them */
+  if (args->flags & EV_ARENA && (
+      args->init_iv_at  == NULL ||
+      args->genome_size == 0)) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* the lazy individuals are allocated without init */
+  if (args->flags & EV_LAZY && !(args->flags & EV_PODG) && 
+      args->alloc_iv == NULL) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* the in place init needs its function */
+  if (args->flags & EV_RINI && args->reinit_iv == NULL) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* the delta mode needs all of its functions */
+  if (args->flags & EV_DLTA && (
+      args->mutate_delta  == NULL ||
+      args->fitness_delta == NULL ||
+      args->apply_delta   == NULL ||
+      args->delta_size    == 0)) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* the undo mode needs both of its functions */
+  if (args->flags & EV_UNDO && (
+      args->mutate_undoable == NULL ||
+      args->undo            == NULL ||
+      args->undo_size       == 0)) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* pod genomes are cloned and freed by their size */
+  if (args->flags & EV_PODG && args->genome_size == 0) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* a tournament needs at least one and at most all parents */
+  if ((args->flags & EV_PARENT_MASK) == EV_PARENT_TOURNAMENT) {
+    int deaths  = (int) ((double) args->population_size * 
+                         args->death_percentage);
+    int parents = (args->flags & EV_KEEP) ? args->population_size - deaths :
+                                            args->population_size;
+
+    if (args->tournament_size < 1 || args->tournament_size > parents) {
+
+      DBG_MSG("wrong opts");
+      return 0;
+    }
+  }
+
+  /* the tuned values must be usable */
+  if (args->flags & EV_TUNE && 
+      (args->min_quicksort < 1 || args->chunks_per_thread < 1 ||
+       args->min_radix < 1)) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* the explicit cpu list must not be empty */
+  if ((args->flags & EV_AFFINITY_MASK) == EV_AFFINITY_LIST && 
+      (args->cpus == NULL || args->num_cpus < 1)) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
   if (args->opts == NULL)
     args->opts = (void**) malloc(sizeof(void *) * args->num_threads);
 
@@ -669,6 +1810,119 @@ static char ev_flags_invalid(uint64_t flags) {
   tflags &= ~EV_VEB1;
   tflags &= ~EV_VEB2;
   tflags &= ~EV_VEB3;
+
+  /**
+   * steady state replaces individuals in place,
+   * so it can only be used when keeping the last generation
+   */
+  if ((tflags & EV_STST) && !(tflags & EV_KEEP))
+    return 1;
+
+  /**
+   * the islands are evolved in place too
+   * and can't be used together with steady state
+   */
+  if ((tflags & EV_ISLE) && (!(tflags & EV_KEEP) || (tflags & EV_STST)))
+    return 1;
+
+  /**
+   * each process is one island which 
+   * evolves in generations of its own
+   */
+  if ((tflags & EV_PROC) && 
+      (!(tflags & EV_KEEP) || (tflags & (EV_STST | EV_ISLE))))
+    return 1;
+
+  /**
+   * the greedy and steady state threads need 
+   * the fitness of each new individual at once
+   */
+  if ((tflags & EV_AFIT) && (tflags & (EV_GRDY | EV_STST)))
+    return 1;
+
+  /**
+   * the partial selection replaces the generation sort, 
+   * the other modes have an selection of their own
+   */
+  if ((tflags & EV_PSEL) && 
+      (tflags & (EV_GRDY | EV_STST | EV_ISLE | EV_PROC)))
+    return 1;
+
+  /**
+   * the merge selection needs the sorted survivors 
+   * of the last generation
+   */
+  if ((tflags & EV_MSEL) && (!(tflags & EV_KEEP) ||
+      (tflags & (EV_GRDY | EV_STST | EV_ISLE | EV_PSEL))))
+    return 1;
+
+  /**
+   * the parent selections choose out of all parents,
+   * the other modes have an selection of their own
+   */
+  if ((tflags & EV_PARENT_MASK) && (tflags & (EV_GRDY | EV_STST | EV_ISLE | 
+                                              EV_PROC | EV_PSEL | 
+                                              EV_MSEL)))
+    return 1;
+
+  /**
+   * lazy individuals have no fitness untill they were bred,
+   * so they must not be sorted or compared before (evolute and
+   * ev_rank skip the final sort if no generation was bred)
+   */
+  if ((tflags & EV_LAZY) && 
+      (tflags & (EV_GRDY | EV_STST | EV_ISLE)))
+    return 1;
+
+  /**
+   * the genomes in the arena are created once at init,
+   * the other modes create (or free) individuals later on
+   */
+  if ((tflags & EV_ARENA) && (tflags & (EV_GRDY | EV_STST | EV_LAZY)))
+    return 1;
+
+  /**
+   * a delta offspring is only mutated from one parent and materialized
+   * after the selection of its own generation, so the parents have to 
+   * stay in place untill then
+   */
+  if ((tflags & EV_DLTA) && (!(tflags & EV_KEEP) || 
+      (tflags & (EV_UREC | EV_GRDY | EV_STST | EV_ISLE | EV_PROC | 
+                 EV_AFIT | EV_LAZY))))
+    return 1;
+
+  /* only the greedy candidates are mutated in place */
+  if ((tflags & EV_UNDO) && !(tflags & EV_GRDY))
+    return 1;
+
+  /* async greedy is a variant of greedy */
+  if ((tflags & EV_GASY) && !(tflags & EV_GRDY))
+    return 1;
+
+  /**
+   * one of the executors (the shared executor 
+   * or'ed with an other one is none of them)
+   */
+  if ((tflags & EV_EXECUTOR_MASK) > EV_EXECUTOR_SHARED)
+    return 1;
+
+  tflags &= ~EV_STST;
+  tflags &= ~EV_ISLE;
+  tflags &= ~EV_PROC;
+  tflags &= ~EV_EXECUTOR_MASK;
+  tflags &= ~EV_AFFINITY_MASK;
+  tflags &= ~EV_GASY;
+  tflags &= ~EV_AFIT;
+  tflags &= ~EV_LAZY;
+  tflags &= ~EV_TUNE;
+  tflags &= ~EV_PSEL;
+  tflags &= ~EV_MSEL;
+  tflags &= ~EV_PARENT_MASK;
+  tflags &= ~EV_ARENA;
+  tflags &= ~EV_PODG;
+  tflags &= ~EV_RINI;
+  tflags &= ~EV_DLTA;
+  tflags &= ~EV_UNDO;
   
   return tflags != EV_UREC                                   &&
          tflags != (EV_UREC|EV_UMUT)                         &&
@@ -702,29 +1956,100 @@ void evolution_clean_up(Evolution *ev) {
   end = (ev->use_greedy ? ev->population_size : end);
   int i;
 
+  /* the genomes of arena mode are freed at once with their slabs */
+  if (ev->arena != NULL) {
+    for (i = 0; i < ev->arena_slabs; i++)
+      free(ev->arena[i]);
+
+    free(ev->arena);
+    end = 1;
+  }
+
   /**
    * free individuals starting by index one because
-   * zero is the best individual
+   * zero is the best individual (there are only opts for each thread)
    */
-  for (i = 1; i < end; i++) 
-    ev->free_iv(ev->population[i]->iv, 
-                ev->opts[i]);
-
-  free(ev->ivs);
-  free(ev->population);
+  for (i = 1; i < end; i++) {
+    
+    /* lazy individuals wich were never used */
+    if (ev->population[i]->iv == NULL)
+      continue;
 
-  /* free copys from the threads */
-  for (i = 0; i < ev->num_threads && ev->num_threads > 1; i++) {
-    free(ev->thread_args[i]);
-    tc_free(&ev->thread_clients[i]);
-    free(ev->rands[i]);
-  }
-  
-  if (ev->num_threads > 1) {
-    free((void *) ev->thread_args);
-    free(ev->thread_clients);
+    EV_FREE_IV(ev, ev->population[i]->iv, 
+                   ev->opts[i % ev->num_threads]);
   }
 
+  /* free the private offsprings and locks of steady state mode */
+  if (ev->steady_state) {
+    for (i = 0; i < ev->num_threads; i++)
+      EV_FREE_IV(ev, ev->scratch[i]->iv, ev->opts[i]);
+
+    for (i = 0; i < ev->population_size; i++)
+      pthread_mutex_destroy(&ev->iv_locks[i]);
+
+    free(ev->scratch);
+    free(ev->iv_locks);
+  }
+
+  free(ev->merged);
+  free(ev->merge_runs);
+  free(ev->keys);
+  free(ev->undo_logs);
+  free(ev->deltas);
+  free(ev->delta_parents);
+  free(ev->radix_src);
+  free(ev->radix_dst);
+  free(ev->radix_counts);
+  free(ev->alias_prob);
+  free(ev->alias_index);
+  free(ev->alias_weights);
+  free(ev->alias_work);
+
+  /* unmap the migrant rings of process mode */
+  if (ev->use_processes) {
+    munmap(ev->shm, ev->shm_size);
+    ev->shm = NULL;
+  }
+
+  if (ev->cpus != NULL) {
+    munmap(ev->ivs, ev->ivs_space);
+    munmap(ev->population, ev->population_space);
+    free(ev->cpus);
+  } else {
+    free(ev->ivs);
+    free(ev->population);
+  }
+
+  /* shutdown the pool threads */
+  if (ev->num_threads > 1 && ev->executor == EV_EXECUTOR_POOL)
+    ev_stop_barrier(ev);
+
+  /* the shared pool must not see this Evolution any more */
+  if (ev->pool != NULL) {
+    ev_pool_remove(ev->pool, ev);
+    pthread_cond_destroy(&ev->pool_done);
+  }
+
+  /* free copys from the threads */
+  for (i = 0; i < ev->num_threads && ev->num_threads > 1; i++) {
+    pthread_mutex_destroy(&ev->thread_args[i]->lock);
+    free(ev->thread_args[i]->in_flight);
+    free(ev->thread_args[i]);
+    free(ev->rands[i]);
+
+    if (ev->executor == EV_EXECUTOR_TCLIENT)
+      tc_free(&ev->thread_clients[i]);
+  }
+  
+  if (ev->num_threads > 1) {
+    free((void *) ev->thread_args);
+    free(ev->thread_clients);
+    free(ev->pthreads);
+  }
+
+  pthread_mutex_destroy(&ev->mutex);
+  pthread_mutex_destroy(&ev->greedy_lock);
+
   free(ev->rands);
 }
 
@@ -742,6 +2067,32 @@ Individual best_evolution(EvInitArgs *args) {
   return best;
 }
 
+/**
+ * Sorts the whole population of the given Evolution by fitness
+ */
+void ev_rank(Evolution *ev) {
+
+  /* the lazy individuals are not bred yet (the others are sorted) */
+  if (ev->lazy_init && ev->info.generations_progressed == 0)
+    return;
+
+  EV_SORT(ev, 0);
+}
+
+/**
+ * Sets up the individuals behind start (up to overall_end)
+ * wich are created on first use in lazy init mode
+ */
+static void ev_init_lazy_ivs(Evolution *ev, int start) {
+
+  int i;
+  for (i = start; i < ev->overall_end; i++) {
+    ev->population[i]          = ev->ivs + i;
+    ev->population[i]->iv      = NULL;
+    ev->population[i]->fitness = 0;
+  }
+}
+
 /**
  * Parallel init_iv function
  */
@@ -754,23 +2105,26 @@ static void *threadable_init_iv(void *arg) {
   /**
    * Loop untill all individuals of this thread are initialized
    */
+  if (ev->arena != NULL && evt->start < evt->end)
+    ev_arena_slab(ev, evt->index);
+
   for (i = evt->start; i < evt->end; i++) {
      
     /**
      * create new individual
      */
     ev->population[i]     = ev->ivs + i;
-    ev->population[i]->iv = ev->init_iv(evt->opt);
+    ev->population[i]->iv = EV_NEW_IV(ev, i, evt->opt);
     EV_CALC_FITNESS_AT(ev, i, evt->opt);
 
     /**
      * prints status informations if wanted
      */
     if (ev->verbose >= EV_VERBOSE_ONELINE) {
-      EV_INIT_IV_OUTPUT(i);
+      EV_INIT_IV_OUTPUT(*ev, i);
 
       if (ev->verbose >= EV_VERBOSE_HIGH)
-        EV_THREAD_SAVE_NEW_LINE;
+        EV_THREAD_SAVE_NEW_LINE(*ev);
     }
   }
 
@@ -803,8 +2157,7 @@ static void *threadable_greedy_init_iv(void *arg) {
     /**
      * create new individual
      */
-    ev->free_iv(ev->population[start + 1]->iv, evt->opt);
-    ev->population[start + 1]->iv = ev->init_iv(evt->opt);
+    EV_RENEW_IV(ev, start + 1, evt->opt);
     EV_CALC_FITNESS_AT(ev, start + 1, evt->opt);
 
     /* set best individual if neccesary */
@@ -814,10 +2167,10 @@ static void *threadable_greedy_init_iv(void *arg) {
      * prints status informations if wanted
      */
     if (ev->verbose >= EV_VERBOSE_ONELINE) {
-      EV_INIT_IV_OUTPUT(i);
+      EV_INIT_IV_OUTPUT(*ev, i);
 
       if (ev->verbose >= EV_VERBOSE_HIGH)
-        EV_THREAD_SAVE_NEW_LINE;
+        EV_THREAD_SAVE_NEW_LINE(*ev);
     }
   }
 
@@ -854,6 +2207,8 @@ static inline void ev_init_recombinate(Evolution *ev) {
   uint32_t ivs_per_thread = (ev->overall_end - ev->overall_start) /
                             ev->num_threads + 1;
 
+  ev_init_chunks(ev, ivs_per_thread);
+
   /* start parallel working */
   for (j = 0; j < ev->num_threads; j++) {
 
@@ -866,9 +2221,7 @@ static inline void ev_init_recombinate(Evolution *ev) {
     if (ev->thread_args[j]->start > ev->overall_end)
       ev->thread_args[j]->start = ev->overall_end;
 
-    tc_set_rerun_func(&ev->thread_clients[j], 
-                      threadable_recombinate, 
-                      (void *) ev->thread_args[j]);
+    ev_set_thread_func(ev, j, threadable_recombinate);
   }
 
 }
@@ -902,6 +2255,8 @@ static inline void ev_init_mutate(Evolution *ev) {
   uint32_t ivs_per_thread = (ev->overall_end - ev->overall_start) /
                             ev->num_threads + 1;
 
+  ev_init_chunks(ev, ivs_per_thread);
+
   /* setting start and end areas for each thread */
   for (j = 0; j < ev->num_threads; j++) {
 
@@ -924,9 +2279,7 @@ static inline void ev_init_mutate(Evolution *ev) {
     /* start parallel working */
     for (j = 0; j < ev->num_threads; j++) {
 
-      tc_set_rerun_func(&ev->thread_clients[j], 
-                        threadable_mutation_onely_1half, 
-                        (void *) ev->thread_args[j]);
+      ev_set_thread_func(ev, j, threadable_mutation_onely_1half);
     }
 
   /* else choose random survivers to mutate */
@@ -935,9 +2288,7 @@ static inline void ev_init_mutate(Evolution *ev) {
     /* start parallel working */
     for (j = 0; j < ev->num_threads; j++) {
 
-      tc_set_rerun_func(&ev->thread_clients[j], 
-                        threadable_mutation_onely_rand, 
-                        (void *) ev->thread_args[j]);
+      ev_set_thread_func(ev, j, threadable_mutation_onely_rand);
     }
   }
 
@@ -978,10 +2329,16 @@ static inline void ev_init_greedy(Evolution *ev) {
   /* start parallel working */
   for (j = 0; j < ev->num_threads; j++) {
 
-    tc_set_rerun_func(&ev->thread_clients[j], 
-                      threadable_greedy,
-                      (void *) ev->thread_args[j]);
+    ev->thread_args[j]->greedy_seen = 0;
+    ev_set_thread_func(ev, 
+                       j, 
+                       (ev->greedy_async ? threadable_greedy_async :
+                                           threadable_greedy));
   }
+
+  ev->greedy_rounds   = 0;
+  ev->greedy_improovs = 0;
+  ev->greedy_stop     = 0;
 }
 
 
@@ -1002,36 +2359,80 @@ static inline void ev_switch_ivs(Evolution *ev) {
 }
 
 /**
- * Wakeup the Threadabel functions
- * an waits untill all work is done
- * and count the improovs of the
- * progressed generation
+ * Sets the chunk size for the work-stealing scheduler
+ * from the number of individuals calculated by one thread
  */
-static inline void evolute_ivs(Evolution *ev) {
+static inline void ev_init_chunks(Evolution *ev, int ivs_per_thread) {
+  
+  ev->chunk_size = ivs_per_thread / ev->chunks_per_thread;
+
+  if (ev->chunk_size < 1)
+    ev->chunk_size = 1;
+}
+
+/**
+ * Resets the work-stealing cursors of all threads
+ * to their own slice before an generation starts
+ *
+ * Note: the threads are not running at this point,
+ *       so we don't need to lock
+ */
+static inline void ev_reset_chunks(Evolution *ev) {
   
   int j;
 
-  /**
-   * wakeup all threads
-   */
-  for (j = 0; j < ev->num_threads; j++) 
-    tc_rerun(&ev->thread_clients[j]);
+  for (j = 0; j < ev->num_threads; j++) {
+    ev->thread_args[j]->next = ev->thread_args[j]->start;
+    ev->thread_args[j]->last = ev->thread_args[j]->end;
+  }
+}
 
-  /**
-   * Wait untill all threads are finished
-   */
-  for (j = 0; j < ev->num_threads; j++) 
-    tc_join(&ev->thread_clients[j]);
+/**
+ * Takes the next chunk of work for the given thread, first from
+ * the front of its own slice, then by stealing from the back of
+ * the slices of the other threads.
+ * Returns 0 if there is no work left in this generation
+ */
+static inline char ev_next_chunk(EvThreadArgs *evt, int *start, int *end) {
+  
+  Evolution *ev = evt->ev;
+  EvThreadArgs *victim;
+  int j;
+
+  /* take the next chunk of our own slice */
+  pthread_mutex_lock(&evt->lock);
+  if (evt->next < evt->last) {
+    *start    = evt->next;
+    evt->next = (evt->last - evt->next > ev->chunk_size) ? 
+                evt->next + ev->chunk_size : evt->last;
+    *end      = evt->next;
+
+    pthread_mutex_unlock(&evt->lock);
+    return 1;
+  }
+  pthread_mutex_unlock(&evt->lock);
 
   /**
-   * resets and count improovs
-   * of the finished threads
+   * steal from the back of the other slices, starting with 
+   * our neighbour so that the thiefs spread over the victims
    */
-  ev->info.improovs = 0;
+  for (j = 1; j < ev->num_threads; j++) {
+    victim = ev->thread_args[(evt->index + j) % ev->num_threads];
 
-  for (j = 0; j < ev->num_threads; j++)
-    ev->info.improovs += ev->thread_args[j]->improovs;
+    pthread_mutex_lock(&victim->lock);
+    if (victim->next < victim->last) {
+      *end         = victim->last;
+      victim->last = (victim->last - victim->next > ev->chunk_size) ?
+                     victim->last - ev->chunk_size : victim->next;
+      *start       = victim->last;
+
+      pthread_mutex_unlock(&victim->lock);
+      return 1;
+    }
+    pthread_mutex_unlock(&victim->lock);
+  }
 
+  return 0;
 }
 
 /**
@@ -1039,30 +2440,26 @@ static inline void evolute_ivs(Evolution *ev) {
  * an waits untill all work is done
  * and count the improovs of the
  * progressed generation
- *
- * set the best greedy individual as greedy individual
- * for the next generation
  */
-static inline void greedy_ivs(Evolution *ev) {
+static inline void evolute_ivs(Evolution *ev) {
   
   int j;
-  int64_t best_fitness = ev->population[0]->fitness;
-  int best_index  = 0;
+
+  /* give each thread its own slice back */
+  ev_reset_chunks(ev);
 
   /**
    * wakeup all threads
    */
-  for (j = 0; j < ev->num_threads; j++) 
-    tc_rerun(&ev->thread_clients[j]);
+  ev_start_threads(ev);
 
   /**
    * Wait untill all threads are finished
    */
-  for (j = 0; j < ev->num_threads; j++) 
-    tc_join(&ev->thread_clients[j]);
+  ev_wait_threads(ev);
 
   /**
-   * resets, count improovs
+   * resets and count improovs
    * of the finished threads
    */
   ev->info.improovs = 0;
@@ -1070,225 +2467,3064 @@ static inline void greedy_ivs(Evolution *ev) {
   for (j = 0; j < ev->num_threads; j++)
     ev->info.improovs += ev->thread_args[j]->improovs;
 
-  /* find the best greedy individual */
-  for (j = 1; j < ev->num_threads; j++) {
-    
-    if (ev->sort_max) {
-      if (ev->population[j * 3]->fitness > best_fitness) {
-        best_fitness = ev->population[j * 3]->fitness;
-        best_index   = j * 3;
-      } 
-    } else {
-      if (ev->population[j * 3]->fitness < best_fitness) {
-        best_fitness = ev->population[j * 3]->fitness;
-        best_index   = j * 3;
-      } 
-    }
+}
+
+/**
+ * Sets the work of thread j for each generation,
+ * the work is wrapped by threadable_timed to measure 
+ * the barrier wait time 
+ */
+static inline void ev_set_thread_func(Evolution *ev, 
+                                      int j, 
+                                      void *(*func) (void *)) {
+
+  ev->thread_args[j]->func = func;
+
+  if (ev->executor == EV_EXECUTOR_TCLIENT) {
+    tc_set_rerun_func(&ev->thread_clients[j], 
+                      threadable_timed, 
+                      (void *) ev->thread_args[j]);
   }
-  
-  /* copy the best individual to all other threads */
-  for (j = 0; j < ev->num_threads; j++) {
-    if (j * 3 != best_index) {
-      ev->clone_iv(ev->population[j * 3]->iv, ev->population[best_index]->iv, ev->opts[j]);
-      ev->population[j + 3]->fitness = ev->population[best_index]->fitness;
-    }
+}
+
+/**
+ * Wakeup the threads to start the next generation
+ */
+static void ev_start_threads(Evolution *ev) {
+
+  int j;
+  ev->bar_release_ns = ev_time_ns();
+
+  switch (ev->executor) {
+    case EV_EXECUTOR_POOL:
+
+      /* all threads have finished the last generation at this point */
+      __atomic_store_n(&ev->bar_done, 0, __ATOMIC_RELAXED);
+      __atomic_add_fetch(&ev->bar_epoch, 1, __ATOMIC_SEQ_CST);
+
+      if (__atomic_load_n(&ev->bar_sleepers, __ATOMIC_SEQ_CST))
+        syscall(SYS_futex, &ev->bar_epoch, FUTEX_WAKE_PRIVATE, INT_MAX, 
+                NULL, NULL, 0);
+      break;
+
+    case EV_EXECUTOR_PTHREAD:
+      for (j = 0; j < ev->num_threads; j++) 
+        pthread_create(&ev->pthreads[j], 
+                       NULL, 
+                       threadable_timed, 
+                       (void *) ev->thread_args[j]);
+      break;
+
+    /* all work is done by the calling thread */
+    case EV_EXECUTOR_SERIAL:
+      for (j = 0; j < ev->num_threads; j++) 
+        threadable_timed((void *) ev->thread_args[j]);
+      break;
+
+    case EV_EXECUTOR_SHARED:
+      pthread_mutex_lock(&ev->pool->lock);
+      ev->pool_next      = 0;
+      ev->pool_remaining = ev->num_threads;
+      pthread_cond_broadcast(&ev->pool->work);
+      pthread_mutex_unlock(&ev->pool->lock);
+      break;
+
+    default:
+      for (j = 0; j < ev->num_threads; j++) 
+        tc_rerun(&ev->thread_clients[j]);
   }
 }
 
 /**
- * Initializes the evolution process
- * by configurating and starting the threads
- * and choosing what to be done
+ * Waits untill all threads finished the current generation
+ * and calculates the barrier wait time
  */
-static inline void init_evolute(Evolution *ev) {
+static void ev_wait_threads(Evolution *ev) {
+
+  int j;
+  uint32_t done;
+  uint64_t now;
+
+  switch (ev->executor) {
+    case EV_EXECUTOR_POOL:
+      done = __atomic_load_n(&ev->bar_done, __ATOMIC_ACQUIRE);
+      while (done != (uint32_t) ev->num_threads)
+        done = ev_spin_wait(&ev->bar_done, 
+                            done, 
+                            &ev->bar_main_sleeps, 
+                            &ev->bar_spin);
+      break;
+
+    case EV_EXECUTOR_PTHREAD:
+      for (j = 0; j < ev->num_threads; j++) 
+        pthread_join(ev->pthreads[j], NULL);
+      break;
+
+    case EV_EXECUTOR_SERIAL:
+      break;
+
+    /* help the pool with our own tasks while waiting */
+    case EV_EXECUTOR_SHARED:
+      pthread_mutex_lock(&ev->pool->lock);
+
+      while (ev->pool_remaining > 0) {
+        if (ev->pool_next < ev->num_threads) {
+          j = ev->pool_next++;
+          pthread_mutex_unlock(&ev->pool->lock);
+
+          threadable_timed((void *) ev->thread_args[j]);
+
+          pthread_mutex_lock(&ev->pool->lock);
+          ev->pool_remaining--;
+        } else
+          pthread_cond_wait(&ev->pool_done, &ev->pool->lock);
+      }
+
+      pthread_mutex_unlock(&ev->pool->lock);
+      break;
+
+    default:
+      for (j = 0; j < ev->num_threads; j++) 
+        tc_join(&ev->thread_clients[j]);
+  }
 
   /**
-   * init recombinatin or mutatation
-   * depeding on given flags in init
+   * time the threads waited to be started 
+   * and for the other threads to be finished
    */
-  if (ev->use_greedy)
-    ev_init_greedy(ev);
-  else if (ev->use_recombination)
-    ev_init_recombinate(ev);
-  else 
-    ev_init_mutate(ev);
-  
+  now = ev_time_ns();
+  ev->info.barrier_wait_ns = 0;
+
+  for (j = 0; j < ev->num_threads; j++) {
+    ev->info.barrier_wait_ns += ev->thread_args[j]->start_ns - 
+                                ev->bar_release_ns;
+    ev->info.barrier_wait_ns += now - ev->thread_args[j]->finish_ns;
+  }
 }
 
 /**
- * Finishes the Evolution progresse to some verbose work if neccesary
+ * Returns the current (monotonic) time in nanoseconds
  */
-static inline void close_evolute(Evolution *ev) {
+static inline uint64_t ev_time_ns(void) {
 
-  /* clear line if neccesary */
-  if (ev->verbose >= EV_VERBOSE_ONELINE)
-    printf("\33[2K\r");
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
 
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
 }
 
 /**
- * do the actual evolution, which means
- *  - calculate the fitness for each Individual
- *  - sort Individual by fitness
- *  - remove worst ivs
- *  - grow a new generation
+ * Spins and than sleeps on an futex untill *addr != val,
+ * returns the new value of *addr
  *
- * Retruns the best individual
+ * Note: sleepers is incremented befor sleeping, so the
+ *       thread changing *addr only needs to wake the futex 
+ *       if there are sleepers
  */
-Individual *evolute(Evolution *ev) {
+static uint32_t ev_spin_wait(uint32_t *addr, 
+                             uint32_t val, 
+                             uint32_t *sleepers, 
+                             int *spin) {
 
+  uint32_t now;
   int i;
 
-  /**
-   * initalize the evolution process
-   */
-  init_evolute(ev);
-
-  /**
-   * print status informations if wanted
-   */
-  if (ev->verbose >= EV_VERBOSE_HIGH && ev->use_greedy)
-    EV_GREEDY_OUTPUT(*ev);
+  for (i = 0; i < *spin; i++) {
+    now = __atomic_load_n(addr, __ATOMIC_ACQUIRE);
 
-  /**
-   * Generation loop
-   * each loop lets one generation grow kills the worst individuals
-   * and let new individuals born (depending on the previous given flags)
-   */
-  for (i = 0; 
-       i < ev->generation_limit && 
-       (!ev->use_abort_requirement || 
-        ev->continue_ev(ev)); 
-       i++) {
+    /* spinning was succesfull, spin longer next time */
+    if (now != val) {
+      if (*spin < EV_SPIN_MAX)
+        *spin *= 2;
 
-    /**
-     * recombinates or mutates individuals
-     * depeding on given flags in init
-     */
-    if (ev->num_threads > 1) {
-      if (ev->use_greedy)
-        greedy_ivs(ev);
-      else
-        evolute_ivs(ev);
-    } else {
-      if (ev->use_greedy)
-        greedy_ivs_seriel(ev);
-      else
-        evolute_ivs_seriel(ev);
+      return now;
     }
+
+    EV_CPU_RELAX();
+  }
+
+  /* spinning was in vain, spin shorter next time */
+  if (*spin > EV_SPIN_MIN)
+    *spin /= 2;
+
+  for (;;) {
+    __atomic_add_fetch(sleepers, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+    __atomic_sub_fetch(sleepers, 1, __ATOMIC_SEQ_CST);
+
+    now = __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+    if (now != val)
+      return now;
+  }
+}
+
+/**
+ * Starts the threads of the spin barrier
+ */
+static void ev_start_barrier(Evolution *ev) {
+
+  int j;
+
+  ev->bar_epoch       = 0;
+  ev->bar_done        = 0;
+  ev->bar_sleepers    = 0;
+  ev->bar_main_sleeps = 0;
+  ev->bar_stop        = 0;
+
+  for (j = 0; j < ev->num_threads; j++) {
+    pthread_create(&ev->pthreads[j], 
+                   NULL, 
+                   threadable_barrier, 
+                   (void *) ev->thread_args[j]);
+  }
+}
+
+/**
+ * Stops the threads of the spin barrier
+ */
+static void ev_stop_barrier(Evolution *ev) {
+
+  int j;
+
+  __atomic_store_n(&ev->bar_stop, 1, __ATOMIC_RELEASE);
+  ev_start_threads(ev);
+
+  for (j = 0; j < ev->num_threads; j++) 
+    pthread_join(ev->pthreads[j], NULL);
+}
+
+/**
+ * Returns a new thread pool with num_threads threads, wich can be
+ * shared by many Evolutions
+ */
+EvPool *new_ev_pool(int num_threads) {
+
+  int i;
+  EvPool *pool;
+
+  if (num_threads < 1) {
+    DBG_MSG("wrong opts");
+    return NULL;
+  }
+
+  pool = (EvPool *) malloc(sizeof(EvPool));
+
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work, NULL);
+
+  pool->num_threads = num_threads;
+  pool->num_clients = 0;
+  pool->max_clients = 16;
+  pool->next_client = 0;
+  pool->stop        = 0;
+  pool->clients     = (Evolution **) malloc(sizeof(Evolution *) * 
+                                            pool->max_clients);
+  pool->threads     = (pthread_t *) malloc(sizeof(pthread_t) * num_threads);
+
+  for (i = 0; i < num_threads; i++)
+    pthread_create(&pool->threads[i], NULL, threadable_pool, pool);
+
+  return pool;
+}
+
+/**
+ * Stops the threads and frees the given pool
+ */
+void ev_pool_free(EvPool *pool) {
   
-    /**
-     * switch old and new generation to discard the old one
-     * which will be overidden next time
-     */
-    if (!ev->keep_last_generation && !ev->use_greedy)
-      ev_switch_ivs(ev);
+  int i;
 
-    /**
-     * Select the best individuals to survindividuale,
-     * Sort the Individuals by theur fittnes
-     */
-    if (!ev->use_greedy)
-      EV_SELECTION(ev);
+  pthread_mutex_lock(&pool->lock);
+  pool->stop = 1;
+  pthread_cond_broadcast(&pool->work);
+  pthread_mutex_unlock(&pool->lock);
 
-    /* update progressed generations */
-    ev->info.generations_progressed = i + 1;
+  for (i = 0; i < pool->num_threads; i++)
+    pthread_join(pool->threads[i], NULL);
 
-    /**
-     * print status informations if wanted
-     */
-    if (ev->verbose >= EV_VERBOSE_HIGH && ev->use_greedy)
+  pthread_cond_destroy(&pool->work);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool->threads);
+  free(pool->clients);
+  free(pool);
+}
+
+/**
+ * Adds an Evolution to the clients of the given pool
+ */
+static void ev_pool_add(EvPool *pool, Evolution *ev) {
+
+  pthread_mutex_lock(&pool->lock);
+
+  if (pool->num_clients == pool->max_clients) {
+    pool->max_clients *= 2;
+    pool->clients      = (Evolution **) realloc(pool->clients, 
+                                                sizeof(Evolution *) *
+                                                pool->max_clients);
+  }
+
+  pool->clients[pool->num_clients++] = ev;
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Removes an Evolution from the clients of the given pool
+ */
+static void ev_pool_remove(EvPool *pool, Evolution *ev) {
+
+  int i;
+
+  pthread_mutex_lock(&pool->lock);
+
+  for (i = 0; i < pool->num_clients; i++) {
+    if (pool->clients[i] == ev) {
+      pool->clients[i] = pool->clients[--pool->num_clients];
+      break;
+    }
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Returns the Evolution wich gets the next thread of the pool
+ * (round robin) and sets task to the task to be done, 
+ * or NULL if there is no task (pool must be locked)
+ */
+static Evolution *ev_pool_next_task(EvPool *pool, int *task) {
+
+  int i, c;
+  Evolution *ev;
+
+  for (i = 0; i < pool->num_clients; i++) {
+    c  = (pool->next_client + i) % pool->num_clients;
+    ev = pool->clients[c];
+
+    if (ev->pool_next < ev->num_threads && ev->pool_remaining > 0) {
+      *task             = ev->pool_next++;
+      pool->next_client = (c + 1) % pool->num_clients;
+      return ev;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Allocates the genome slab of the given thread slice in arena mode
+ */
+static void ev_arena_slab(Evolution *ev, int slab) {
+
+  size_t size = ev->genome_stride * ev->arena_ivs;
+  void *mem;
+
+  if (posix_memalign(&mem, EV_ARENA_ALIGN, size) != 0) {
+    ERR_MSG("failed to allocate an genome slab");
+    abort();
+  }
+
+  ev->arena[slab] = (char *) mem;
+}
+
+/**
+ * Initializes the genome of the individual at the given 
+ * possition inside its slab and returns it
+ */
+static void *ev_arena_init_at(Evolution *ev, int i, void *opt) {
+
+  void *genome = EV_ARENA_GENOME(ev, i);
+  ev->init_iv_at(genome, opt);
+
+  return genome;
+}
+
+/**
+ * Copies the best individual out of the arena into arena_best,
+ * its genome belongs to the caller of evolute
+ * (so each evolute gets an new one)
+ */
+static void ev_arena_release_best(Evolution *ev) {
+
+  void *genome = malloc(ev->genome_size);
+
+  if (genome == NULL) {
+    ERR_MSG("failed to allocate the best genome");
+    abort();
+  }
+
+  /* pod genomes need no init to be cloned into */
+  if (!ev->pod_genome)
+    ev->init_iv_at(genome, *ev->opts);
+
+  EV_CLONE_IV(ev, genome, ev->population[0]->iv, *ev->opts);
+  ev->arena_best.iv      = genome;
+  ev->arena_best.fitness = ev->population[0]->fitness;
+}
+
+/**
+ * Materializes the pending offsprings of the population [0, end)
+ * in delta mode: clones their parent and applies their patch
+ * (on all threads)
+ *
+ * the parents are survivors of the previous generation wich
+ * are not overridden before, and no offspring is a parent,
+ * so the threads only read the parents
+ */
+static void ev_delta_apply(Evolution *ev, int end) {
+
+  void *(*func) (void *);
+  int i;
+
+  if (ev->num_threads <= 1) {
+    ev_delta_apply_part(ev, 0, end, *ev->opts);
+    return;
+  }
+
+  ev->delta_end = end;
+
+  func = ev->thread_args[0]->func;
+  for (i = 0; i < ev->num_threads; i++)
+    ev_set_thread_func(ev, i, threadable_delta_apply);
+
+  ev_start_threads(ev);
+  ev_wait_threads(ev);
+
+  /* the work of the next generation */
+  for (i = 0; i < ev->num_threads; i++)
+    ev_set_thread_func(ev, i, func);
+}
+
+/**
+ * Materializes the pending offsprings of the population [start, end)
+ */
+static void ev_delta_apply_part(Evolution *ev, int start, int end, void *opt) {
+
+  Individual *child, *parent;
+  int i, k;
+
+  for (i = start; i < end; i++) {
+    child  = ev->population[i];
+    k      = (int) (child - ev->ivs);
+    parent = ev->delta_parents[k];
+
+    if (parent == NULL)
+      continue;
+
+    EV_CLONE_IV(ev, child->iv, parent->iv, opt);
+    ev->apply_delta(child->iv, EV_DELTA_AT(ev, k), opt);
+    ev->delta_parents[k] = NULL;
+  }
+}
+
+/**
+ * Thread function wich materializes the offsprings of its part 
+ * of [0, delta_end)
+ */
+static void *threadable_delta_apply(void *arg) {
+
+  EvThreadArgs *evt = arg;
+  Evolution *ev     = evt->ev;
+  int start = (int) ((int64_t) evt->index * ev->delta_end / ev->num_threads);
+  int end   = (int) ((int64_t) (evt->index + 1) * ev->delta_end / 
+                     ev->num_threads);
+
+  ev_delta_apply_part(ev, start, end, evt->opt);
+  return NULL;
+}
+
+/**
+ * Fills the fitness keys [start, start + len) from the population
+ */
+static void ev_keys_fill(Evolution *ev, int start, int len) {
+
+  Individual **pop = ev->population;
+  EvKey *keys      = ev->keys;
+  int i;
+
+  for (i = start; i < start + len; i++) {
+    keys[i].key = EV_FITNESS_KEY(ev, pop[i]->fitness);
+    keys[i].iv  = pop[i];
+  }
+}
+
+/**
+ * Permutes the population [start, start + len) 
+ * into the order of the fitness keys
+ */
+static void ev_keys_store(Evolution *ev, int start, int len) {
+
+  Individual **pop = ev->population;
+  EvKey *keys      = ev->keys;
+  int i;
+
+  for (i = start; i < start + len; i++)
+    pop[i] = keys[i].iv;
+}
+
+/**
+ * Moves the k best individuals to the front of the population 
+ * (unsorted, but with the best individual at index zero)
+ *
+ * works on the dense fitness keys and permutes the population 
+ * once at the end, complexity is in O(n) on average (quickselect) 
+ * and O(n log n) in the worst case (introselect)
+ */
+static void ev_partition(Evolution *ev, int k) {
+
+  EvKey *keys = ev->keys;
+  EvKey tmp;
+  uint64_t pivot;
+  int lo = 0, hi = ev->population_size - 1, i, j, best = 0, depth = 0;
+
+  ev_keys_fill(ev, 0, ev->population_size);
+
+  /* allowed partition rounds before falling back to sort */
+  for (i = ev->population_size; i > 0; i >>= 1)
+    depth += 2;
+
+  /**
+   * quickselect untill keys[k] is in its sorted place
+   * so that [0, k) are better or equal than [k, population_size)
+   */
+  while (k < ev->population_size && lo < hi) {
+
+    /* bad pivots: sort the remaining range */
+    if (depth-- == 0) {
+      EV_KEY_SORT_AT(ev, lo, hi - lo + 1);
+      break;
+    }
+
+    pivot = keys[lo + (hi - lo) / 2].key;
+    i     = lo;
+    j     = hi;
+
+    while (i <= j) {
+      while (keys[i].key < pivot) i++;
+      while (pivot < keys[j].key) j--;
+
+      if (i <= j) {
+        tmp     = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+        i++;
+        j--;
+      }
+    }
+
+    if (k <= j)
+      hi = j;
+    else if (k >= i)
+      lo = i;
+    else
+      break;
+  }
+
+  /* move the best one to the front */
+  if (k > ev->population_size)
+    k = ev->population_size;
+
+  for (i = 1; i < k; i++) 
+    if (keys[i].key < keys[best].key)
+      best = i;
+
+  tmp        = keys[0];
+  keys[0]    = keys[best];
+  keys[best] = tmp;
+
+  ev_keys_store(ev, 0, ev->population_size);
+}
+
+/**
+ * Returns the index of one parent out of the parents [base, base + n)
+ * depending on the parent selection
+ */
+static int ev_pick_parent(Evolution *ev, int base, int n, rand128_t *v_rand) {
+
+  Individual **parents = ev->population;
+  int i, best, next;
+
+  switch (ev->parent_selection) {
+    case EV_PARENT_TOURNAMENT:
+      best = base + rand128(v_rand) % n;
+
+      for (i = 1; i < ev->tournament_size; i++) {
+        next = base + rand128(v_rand) % n;
+
+        if (EV_BETTER(ev, parents[next]->fitness, parents[best]->fitness))
+          best = next;
+      }
+      return best;
+
+    /* the alias table is build over [0, overall_start) */
+    case EV_PARENT_PROPORTIONAL:
+    case EV_PARENT_RANK:
+      i = rand128(v_rand) % n;
+      if ((rand128(v_rand) & EV_ALIAS_MASK) < ev->alias_prob[i])
+        return base + i;
+
+      return base + ev->alias_index[i];
+
+    default:
+      return base + rand128(v_rand) % n;
+  }
+}
+
+/**
+ * Returns the index of an second parent out of the parents 
+ * [base, base + n) wich differs from the first one (if n > 1)
+ *
+ * Note: a big tournament or a dominating parent nearly allways 
+ *       picks the first one again, so after EV_PARENT_RETRIES
+ *       the second one is picked uniformly out of the others
+ */
+static int ev_pick_second_parent(Evolution *ev, 
+                                 int first, 
+                                 int base, 
+                                 int n, 
+                                 rand128_t *v_rand) {
+
+  int i, second;
+
+  if (n < 2)
+    return first;
+
+  for (i = 0; i < EV_PARENT_RETRIES; i++) {
+    second = ev_pick_parent(ev, base, n, v_rand);
+
+    if (second != first)
+      return second;
+  }
+
+  /* skip the first one */
+  second = base + rand128(v_rand) % (n - 1);
+  return second >= first ? second + 1 : second;
+}
+
+/**
+ * Builds the alias table over the parents [0, overall_start)
+ * for the proportional or the rank selection
+ *
+ * complexity is in O(n) (Vose's alias method)
+ */
+static void ev_alias_build(Evolution *ev) {
+
+  Individual **pop = ev->population;
+  double *p        = ev->alias_weights;
+  int *work        = ev->alias_work;
+  int n            = ev->overall_start;
+  int64_t worst    = pop[0]->fitness;
+  double sum       = 0;
+  int i, small, large, num_small = 0, first_large = n;
+
+  /* the proportional selection weights the distance to the worst one */
+  if (ev->parent_selection == EV_PARENT_PROPORTIONAL) {
+    for (i = 1; i < n; i++)
+      if (EV_BETTER(ev, worst, pop[i]->fitness))
+        worst = pop[i]->fitness;
+
+    /* the distance can exceed int64_t, but not uint64_t */
+    for (i = 0; i < n; i++) {
+      p[i] = (double) (pop[i]->fitness > worst ? 
+                       (uint64_t) pop[i]->fitness - (uint64_t) worst :
+                       (uint64_t) worst - (uint64_t) pop[i]->fitness);
+      p[i] += 1;
+      sum  += p[i];
+    }
+  } else {
+    for (i = 0; i < n; i++) {
+      p[i] = n - i;
+      sum += p[i];
+    }
+  }
+
+  /**
+   * scale the weights to an average of one and split them into 
+   * small ones [0, num_small) and large ones [first_large, n)
+   */
+  for (i = 0; i < n; i++) {
+    p[i] = p[i] * n / sum;
+
+    if (p[i] < 1)
+      work[num_small++] = i;
+    else
+      work[--first_large] = i;
+  }
+
+  /* fill up each small one with an large one */
+  while (num_small > 0 && first_large < n) {
+    small = work[--num_small];
+    large = work[first_large];
+
+    ev->alias_prob[small]  = (uint32_t) (p[small] * EV_ALIAS_FULL);
+    ev->alias_index[small] = large;
+
+    p[large] = (p[large] + p[small]) - 1;
+    if (p[large] < 1) {
+      first_large++;
+      work[num_small++] = large;
+    }
+  }
+
+  /* the remaining ones are (up to rounding errors) full */
+  while (num_small > 0) {
+    small                  = work[--num_small];
+    ev->alias_prob[small]  = EV_ALIAS_FULL;
+    ev->alias_index[small] = small;
+  }
+
+  for (; first_large < n; first_large++) {
+    large                  = work[first_large];
+    ev->alias_prob[large]  = EV_ALIAS_FULL;
+    ev->alias_index[large] = large;
+  }
+}
+
+/**
+ * Sorts the population with an LSD radix sort over the fitness
+ *
+ * complexity is in O(n * 64 / EV_RADIX_BITS), passes wich would
+ * put all individuals into the same bucket are skipped
+ */
+static void ev_radix_sort(Evolution *ev, char parallel) {
+
+  int parts = (parallel && ev->num_threads > 1) ? ev->num_threads : 1;
+  EvKey *tmp;
+  int shift;
+
+  if (ev->radix_src == NULL) {
+    ev->radix_src    = (EvKey *) malloc(sizeof(EvKey) * 
+                                              ev->population_size);
+    ev->radix_dst    = (EvKey *) malloc(sizeof(EvKey) * 
+                                              ev->population_size);
+    ev->radix_counts = (size_t *) malloc(sizeof(size_t) * 
+                                         EV_RADIX_BUCKETS * 
+                                         ev->num_threads);
+  }
+
+  /* the first count also fills in the keys */
+  ev->radix_phase = EV_RADIX_FILL;
+
+  for (shift = 0; shift < 64; shift += EV_RADIX_BITS) {
+    ev->radix_shift = shift;
+    ev_radix_run(ev, parts);
+    ev->radix_phase = EV_RADIX_COUNT;
+
+    if (!ev_radix_offsets(ev, parts))
+      continue;
+
+    ev->radix_phase = EV_RADIX_SCATTER;
+    ev_radix_run(ev, parts);
+    ev->radix_phase = EV_RADIX_COUNT;
+
+    tmp           = ev->radix_src;
+    ev->radix_src = ev->radix_dst;
+    ev->radix_dst = tmp;
+  }
+
+  ev->radix_phase = EV_RADIX_COPY;
+  ev_radix_run(ev, parts);
+}
+
+/**
+ * Runs the current radix phase on the given number of parts
+ * (on the threads if there is more than one part)
+ */
+static void ev_radix_run(Evolution *ev, int parts) {
+
+  void *(*func) (void *);
+  int i;
+
+  if (parts == 1) {
+    ev_radix_part(ev, 0, 1);
+    return;
+  }
+
+  func = ev->thread_args[0]->func;
+  for (i = 0; i < ev->num_threads; i++)
+    ev_set_thread_func(ev, i, threadable_radix);
+
+  ev_start_threads(ev);
+  ev_wait_threads(ev);
+
+  /* the work of the next generation */
+  for (i = 0; i < ev->num_threads; i++)
+    ev_set_thread_func(ev, i, func);
+}
+
+/**
+ * Runs the current radix phase for one part of the population
+ */
+static void ev_radix_part(Evolution *ev, int part, int parts) {
+
+  Individual **pop = ev->population;
+  EvKey *src       = ev->radix_src;
+  EvKey *dst       = ev->radix_dst;
+  size_t *counts   = ev->radix_counts + (size_t) part * EV_RADIX_BUCKETS;
+  int shift        = ev->radix_shift;
+  int lo           = (int) ((int64_t) ev->population_size * part / parts);
+  int hi           = (int) ((int64_t) ev->population_size * 
+                            (part + 1) / parts);
+  int i;
+
+  switch (ev->radix_phase) {
+    case EV_RADIX_FILL:
+      for (i = lo; i < hi; i++) {
+        src[i].key = EV_FITNESS_KEY(ev, pop[i]->fitness);
+        src[i].iv  = pop[i];
+      }
+      /* fall through */
+
+    case EV_RADIX_COUNT:
+      memset(counts, 0, sizeof(size_t) * EV_RADIX_BUCKETS);
+
+      for (i = lo; i < hi; i++)
+        counts[(src[i].key >> shift) & (EV_RADIX_BUCKETS - 1)]++;
+      break;
+
+    case EV_RADIX_SCATTER:
+      for (i = lo; i < hi; i++)
+        dst[counts[(src[i].key >> shift) & (EV_RADIX_BUCKETS - 1)]++] = 
+          src[i];
+      break;
+
+    case EV_RADIX_COPY:
+      for (i = lo; i < hi; i++)
+        pop[i] = src[i].iv;
+      break;
+  }
+}
+
+/**
+ * Turns the bucket counts of the parts into the offsets where each part 
+ * scatters its items, returns 0 if all items are in the same bucket
+ * (the items of the same bucket stay in order, so the sort is stable)
+ */
+static char ev_radix_offsets(Evolution *ev, int parts) {
+
+  size_t *counts = ev->radix_counts;
+  size_t sum = 0, count, tmp;
+  int b, p;
+
+  for (b = 0; b < EV_RADIX_BUCKETS; b++) {
+    for (p = 0, count = 0; p < parts; p++)
+      count += counts[p * EV_RADIX_BUCKETS + b];
+
+    if (count == (size_t) ev->population_size)
+      return 0;
+
+    for (p = 0; p < parts; p++) {
+      tmp                              = counts[p * EV_RADIX_BUCKETS + b];
+      counts[p * EV_RADIX_BUCKETS + b] = sum;
+      sum                             += tmp;
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * Thread function wich runs the current radix phase for its part
+ */
+static void *threadable_radix(void *arg) {
+
+  EvThreadArgs *evt = arg;
+
+  ev_radix_part(evt->ev, evt->index, evt->ev->num_threads);
+  return NULL;
+}
+
+/**
+ * Sorts the new individuals of each thread slice (in parallel)
+ * and merges them with the sorted survivors
+ *
+ * complexity is in O(deaths / num_threads * log(deaths / num_threads))
+ * for the sorting and O(n log(num_threads)) for the merging
+ */
+static void ev_merge_selection(Evolution *ev) {
+
+  int *runs = ev->merge_runs;
+  int i, j, n = 0;
+  void *(*func) (void *);
+
+  runs[n++] = 0;
+  runs[n++] = ev->survivors;
+
+  /* sort the slices (each slice is one run) */
+  if (ev->num_threads > 1) {
+    func = ev->thread_args[0]->func;
+    for (i = 0; i < ev->num_threads; i++)
+      ev_set_thread_func(ev, i, threadable_sort_slice);
+
+    ev_start_threads(ev);
+    ev_wait_threads(ev);
+
+    /* the breeding function of the next generation */
+    for (i = 0; i < ev->num_threads; i++)
+      ev_set_thread_func(ev, i, func);
+
+    for (i = 0; i < ev->num_threads; i++)
+      if (ev->thread_args[i]->end > runs[n - 1])
+        runs[n++] = ev->thread_args[i]->end;
+  } else {
+    EV_SELECTION_AT(ev, ev->survivors, ev->deaths);
+    runs[n++] = ev->population_size;
+  }
+
+  /**
+   * merge two neighbouring runs untill only one is left
+   * (runs[i] is the start of run i, runs[n - 1] the end of the last)
+   */
+  while (n > 2) {
+    for (i = 0, j = 0; i + 2 < n; i += 2) {
+      ev_merge_runs(ev, runs[i], runs[i + 1], runs[i + 2]);
+      runs[j++] = runs[i];
+    }
+
+    if (i == n - 2)
+      runs[j++] = runs[i];
+
+    runs[j++] = runs[n - 1];
+    n         = j;
+  }
+}
+
+/**
+ * Merges the sorted runs [lo, mid) and [mid, hi) of the population
+ */
+static void ev_merge_runs(Evolution *ev, int lo, int mid, int hi) {
+
+  Individual **pop = ev->population;
+  int i = lo, j = mid, k = lo;
+
+  while (i < mid && j < hi) {
+    if (EV_BETTER(ev, pop[j]->fitness, pop[i]->fitness))
+      ev->merged[k++] = pop[j++];
+    else
+      ev->merged[k++] = pop[i++];
+  }
+
+  while (i < mid) ev->merged[k++] = pop[i++];
+  while (j < hi)  ev->merged[k++] = pop[j++];
+
+  memcpy(pop + lo, ev->merged + lo, sizeof(Individual *) * (hi - lo));
+}
+
+/**
+ * Thread function wich sorts the slice of one thread
+ */
+static void *threadable_sort_slice(void *arg) {
+
+  EvThreadArgs *evt = arg;
+
+  if (evt->end > evt->start)
+    EV_SELECTION_AT(evt->ev, evt->start, evt->end - evt->start);
+
+  return NULL;
+}
+
+/**
+ * Wakeup the Threadabel functions
+ * an waits untill all work is done
+ * and count the improovs of the
+ * progressed generation
+ *
+ * set the best greedy individual as greedy individual
+ * for the next generation
+ */
+static inline void greedy_ivs(Evolution *ev) {
+  
+  int j;
+  int64_t best_fitness = ev->population[0]->fitness;
+  int best_index  = 0;
+
+  /**
+   * wakeup all threads
+   */
+  ev_start_threads(ev);
+
+  /**
+   * Wait untill all threads are finished
+   */
+  ev_wait_threads(ev);
+
+  /**
+   * resets, count improovs
+   * of the finished threads
+   */
+  ev->info.improovs = 0;
+
+  for (j = 0; j < ev->num_threads; j++)
+    ev->info.improovs += ev->thread_args[j]->improovs;
+
+  /* find the best greedy individual */
+  for (j = 1; j < ev->num_threads; j++) {
+    
+    if (ev->sort_max) {
+      if (ev->population[j * 3]->fitness > best_fitness) {
+        best_fitness = ev->population[j * 3]->fitness;
+        best_index   = j * 3;
+      } 
+    } else {
+      if (ev->population[j * 3]->fitness < best_fitness) {
+        best_fitness = ev->population[j * 3]->fitness;
+        best_index   = j * 3;
+      } 
+    }
+  }
+  
+  /* copy the best individual to all other threads */
+  for (j = 0; j < ev->num_threads; j++) {
+    if (j * 3 != best_index) {
+      EV_CLONE_IV(ev, ev->population[j * 3]->iv, ev->population[best_index]->iv, ev->opts[j]);
+      ev->population[j * 3]->fitness = ev->population[best_index]->fitness;
+    }
+  }
+}
+
+/**
+ * in steady state mode each thread has its own private offspring
+ * individual and each slot of the population is guarded by a lock
+ */
+static void ev_init_steady_state_ivs(Evolution *ev) {
+  
+  int i;
+
+  ev->iv_locks = (pthread_mutex_t *) malloc(sizeof(pthread_mutex_t) * 
+                                            ev->population_size);
+  ev->scratch  = (Individual **) malloc(sizeof(Individual *) * 
+                                        ev->num_threads);
+
+  for (i = 0; i < ev->population_size; i++)
+    pthread_mutex_init(&ev->iv_locks[i], NULL);
+
+  /* the private individuals are stored behind the population */
+  for (i = 0; i < ev->num_threads; i++) {
+    ev->scratch[i]     = ev->ivs + ev->population_size + i;
+    ev->scratch[i]->iv = ev->init_iv(ev->opts[i]);
+  }
+}
+
+/**
+ * sets up the threads for steady state mode
+ */
+static inline void ev_init_steady_state(Evolution *ev) {
+
+  int j;
+
+  ev->overall_start   = 0;
+  ev->overall_end     = ev->population_size;
+  ev->steady_born     = 0;
+  ev->steady_improovs = 0;
+  ev->steady_stop     = 0;
+
+  /* break if we using serial version */
+  if (ev->num_threads <= 1) return;
+
+  for (j = 0; j < ev->num_threads; j++)
+    ev_set_thread_func(ev, j, threadable_steady_state);
+}
+
+/**
+ * Wakeup the steady state threads
+ * an waits untill all generations are done
+ * or continue_ev returned 0
+ */
+static inline void steady_state_ivs(Evolution *ev) {
+  
+  /**
+   * continue_ev is called before the first generation like in the 
+   * generation loop, afterwards it is called by the threads
+   */
+  if (ev->generation_limit <= 0 || !ev_continue(ev, *ev->opts))
+    return;
+
+  if (ev->num_threads <= 1) {
+    ev_steady_state(ev, 0, *ev->opts);
+    return;
+  }
+
+  /**
+   * wakeup all threads
+   */
+  ev_start_threads(ev);
+
+  /**
+   * Wait untill all threads are finished
+   */
+  ev_wait_threads(ev);
+}
+
+/**
+ * Runs the async greedy threads untill all generations are done
+ * or continue_ev returned 0 and moves the best individual to index zero
+ */
+static void greedy_async_ivs(Evolution *ev) {
+
+  int j, best = 0;
+  Individual *tmp_iv;
+
+  /* continue_ev is called before the first generation */
+  if (ev->generation_limit <= 0 || !ev_continue(ev, *ev->opts))
+    return;
+
+  /* publish the best of the initialized threads */
+  for (j = 1; j < ev->num_threads; j++) {
+    if (EV_BETTER(ev, 
+                  EV_FITNESS_AT(ev, ev->thread_args[j]->start),
+                  EV_FITNESS_AT(ev, ev->thread_args[best]->start))) {
+      
+      best = j;
+    }
+  }
+
+  ev->greedy_version = 1;
+  ev->greedy_owner   = best;
+  ev->greedy_fitness = EV_FITNESS_AT(ev, ev->thread_args[best]->start);
+  best               = 0;
+
+  /**
+   * wakeup all threads
+   */
+  ev_start_threads(ev);
+
+  /**
+   * Wait untill all threads are finished
+   */
+  ev_wait_threads(ev);
+
+  /* the best of all threads becomes the best individual */
+  for (j = 1; j < ev->num_threads; j++) {
+    if (EV_BETTER(ev, 
+                  EV_FITNESS_AT(ev, ev->thread_args[j]->start),
+                  EV_FITNESS_AT(ev, best))) {
+      
+      best = ev->thread_args[j]->start;
+    }
+  }
+
+  tmp_iv               = ev->population[0];
+  ev->population[0]    = ev->population[best];
+  ev->population[best] = tmp_iv;
+}
+
+/**
+ * sets up one island for each thread
+ */
+static inline void ev_init_islands(Evolution *ev) {
+
+  int j;
+
+  ev->overall_start = 0;
+  ev->overall_end   = ev->population_size;
+
+  /**
+   * spread the population over the islands, 
+   * the sizes of two islands differ at most by one
+   */
+  for (j = 0; j < ev->num_threads; j++) {
+    
+    ev->thread_args[j]->start = (int) ((int64_t) j * ev->population_size / 
+                                       ev->num_threads);
+    ev->thread_args[j]->end   = (int) ((int64_t) (j + 1) * 
+                                       ev->population_size / 
+                                       ev->num_threads);
+
+    ev_set_thread_func(ev, j, threadable_island);
+  }
+}
+
+/**
+ * Wakeup the island threads for one migration interval
+ * and migrates the elites between the islands afterwards,
+ * untill all generations are done or continue_ev returned 0
+ */
+static inline void islands_ivs(Evolution *ev) {
+
+  int i, j, best;
+  Individual *tmp_iv;
+
+  for (i = 0; 
+       i < ev->generation_limit && ev_continue(ev, *ev->opts); 
+       i += ev->island_generations) {
+
+    /* the last interval can be shorter */
+    ev->island_generations = ev->generation_limit - i;
+    if (ev->island_generations > ev->migration_interval)
+      ev->island_generations = ev->migration_interval;
+    
+    /**
+     * wakeup all threads
+     */
+    ev_start_threads(ev);
+
+    /**
+     * Wait untill all threads are finished
+     */
+    ev_wait_threads(ev);
+
+    /**
+     * resets and count the improovs of the finished 
+     * threads (average over the interval)
+     */
+    ev->info.improovs = 0;
+
+    for (j = 0; j < ev->num_threads; j++)
+      ev->info.improovs += ev->thread_args[j]->improovs;
+
+    ev->info.improovs /= ev->island_generations;
+
+    /* exchange the elites between the islands */
+    ev_migrate(ev);
+
+    /**
+     * move the best individual of all islands to index zero,
+     * the islands will be sorted again at the next interval
+     */
+    best = 0;
+    for (j = 1; j < ev->num_threads; j++) {
+      if (EV_BETTER(ev, 
+                    EV_FITNESS_AT(ev, ev->thread_args[j]->start),
+                    EV_FITNESS_AT(ev, best))) {
+        
+        best = ev->thread_args[j]->start;
+      }
+    }
+
+    tmp_iv                  = ev->population[0];
+    ev->population[0]       = ev->population[best];
+    ev->population[best]    = tmp_iv;
+
+    /* update progressed generations */
+    ev->info.generations_progressed = i + ev->island_generations;
+
+    /**
+     * print status informations if wanted
+     */
+    if (ev->verbose >= EV_VERBOSE_HIGH)
+      EV_EVOLUTE_OUTPUT(*ev);
+  }
+}
+
+/**
+ * Copys the elites of each island into the place of the 
+ * worst individuals of the next islands (depending on the topology)
+ *
+ * Note: all islands are sorted at this point and the elites
+ *       and the worst individuals of an island never overlap
+ */
+static void ev_migrate(Evolution *ev) {
+  
+  int dst, src = 0, k, elite = 0;
+  EvThreadArgs *dst_island, *src_island;
+
+  for (dst = 0; dst < ev->num_threads; dst++) {
+
+    dst_island = ev->thread_args[dst];
+
+    /* the random source island is the same for all migrants */
+    if (ev->migration_topology == EV_MIGRATE_RANDOM) {
+      src = rand128(ev->rands[0]) % (ev->num_threads - 1);
+      src = (src >= dst) ? src + 1 : src;
+    }
+
+    for (k = 0; k < ev->migration_size; k++) {
+
+      if (ev->migration_topology == EV_MIGRATE_RING) {
+        src   = (dst + ev->num_threads - 1) % ev->num_threads;
+        elite = k;
+      } else if (ev->migration_topology == EV_MIGRATE_RANDOM) {
+        elite = k;
+      } else {
+        src   = (dst + 1 + k % (ev->num_threads - 1)) % ev->num_threads;
+        elite = k / (ev->num_threads - 1);
+      }
+
+      src_island = ev->thread_args[src];
+
+      EV_CLONE_IV(ev, ev->population[dst_island->end - 1 - k]->iv,
+                      ev->population[src_island->start + elite]->iv,
+                      ev->opts[dst]);
+
+      EV_FITNESS_AT(ev, dst_island->end - 1 - k) = 
+        EV_FITNESS_AT(ev, src_island->start + elite);
+    }
+  }
+}
+
+/**
+ * Returns the size of an shared memory region for 
+ * num_processes processes with the given slot size
+ */
+static inline size_t ev_shm_size(int num_processes, uint64_t slot_size) {
+  return sizeof(EvShmHeader) + 
+         sizeof(EvShmRing) * num_processes + 
+         slot_size * EV_SHM_RING_SLOTS * num_processes;
+}
+
+/**
+ * Maps the shared memory region of an process mode evolution,
+ * returns NULL if it dosn't exists or dosn't fit to the args
+ */
+static void *ev_shm_open(EvInitArgs *args, size_t *size) {
+
+  struct stat st;
+  void *shm;
+  int fd = shm_open(args->shm_name, O_RDWR, 0);
+
+  if (fd < 0)
+    return NULL;
+
+  if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(EvShmHeader)) {
+    close(fd);
+    return NULL;
+  }
+
+  shm = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (shm == MAP_FAILED)
+    return NULL;
+
+  /* check wether the region was created by ev_launch_processes */
+  if (EV_SHM_HEADER(shm)->magic != EV_SHM_MAGIC                  ||
+      EV_SHM_HEADER(shm)->migrant_size == 0                      ||
+      args->process_index >= EV_SHM_HEADER(shm)->num_processes   ||
+      (size_t) st.st_size < ev_shm_size(EV_SHM_HEADER(shm)->num_processes,
+                                        EV_SHM_HEADER(shm)->slot_size)) {
+
+    munmap(shm, st.st_size);
+    return NULL;
+  }
+
+  *size = st.st_size;
+  return shm;
+}
+
+/**
+ * Pushes the best individuals into the ring of the next process
+ * (migrants are droped if the ring is full or if they don't fit
+ * into a slot)
+ */
+static void ev_shm_export(Evolution *ev) {
+
+  int dst         = (ev->process_index + 1) % ev->num_processes;
+  EvShmRing *ring = EV_SHM_RING(ev->shm, dst);
+  uint64_t head   = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+  uint64_t tail   = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+  uint64_t max    = EV_SHM_HEADER(ev->shm)->migrant_size;
+  EvShmSlot *slot;
+  int k;
+
+  for (k = 0; k < ev->migration_size && head - tail < EV_SHM_RING_SLOTS; k++) {
+
+    slot          = EV_SHM_SLOT(ev->shm, dst, head % EV_SHM_RING_SLOTS);
+    slot->fitness = EV_FITNESS_AT(ev, k);
+    slot->size    = ev->serialize_iv(slot + 1, 
+                                     max,
+                                     ev->population[k]->iv, 
+                                     ev->opts[0]);
+
+    /* the next slot was overwritten */
+    if (slot->size > max) {
+      ERR_MSG("serialize_iv wrote more than migrant_size bytes");
+      abort();
+    }
+
+    /* the migrant doesn't fit, the slot is reused */
+    if (slot->size == 0)
+      continue;
+
+    head++;
+  }
+
+  /* publish the new migrants */
+  __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+}
+
+/**
+ * Pops the migrants of the previous process into 
+ * the place of the worst new individuals
+ */
+static void ev_shm_import(Evolution *ev) {
+
+  EvShmRing *ring = EV_SHM_RING(ev->shm, ev->process_index);
+  uint64_t tail   = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+  uint64_t head   = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+  int last        = ev->population_size - 1;
+  EvShmSlot *slot;
+  int k;
+
+  for (k = 0; k < ev->migration_size && tail != head; k++) {
+
+    slot = EV_SHM_SLOT(ev->shm, ev->process_index, tail % EV_SHM_RING_SLOTS);
+
+    ev->deserialize_iv(ev->population[last - k]->iv, 
+                       slot + 1, 
+                       slot->size, 
+                       ev->opts[0]);
+
+    EV_FITNESS_AT(ev, last - k) = slot->fitness;
+    tail++;
+  }
+
+  /* release the slots for the previous process */
+  __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+}
+
+/**
+ * Pins the calling process to its part of the available cpus
+ *
+ * Note: the cpus are split into contiguous blocks which on most 
+ *       machines corresponds to the sockets / NUMA nodes, so the
+ *       memory of the process is allocated on its own node
+ */
+static void ev_pin_process(int index, int num_processes) {
+
+  cpu_set_t allowed, mine;
+  int cpus[CPU_SETSIZE];
+  int i, n = 0, start, end;
+
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) < 0)
+    return;
+
+  for (i = 0; i < CPU_SETSIZE; i++)
+    if (CPU_ISSET(i, &allowed))
+      cpus[n++] = i;
+
+  if (n == 0)
+    return;
+
+  start = (int) ((int64_t) index * n / num_processes);
+  end   = (int) ((int64_t) (index + 1) * n / num_processes);
+
+  CPU_ZERO(&mine);
+
+  /* more processes than cpus */
+  if (start == end)
+    CPU_SET(cpus[index % n], &mine);
+
+  for (i = start; i < end; i++)
+    CPU_SET(cpus[i], &mine);
+
+  sched_setaffinity(0, sizeof(cpu_set_t), &mine);
+}
+
+/**
+ * Returns the cpu of each thread depending on the affinity flags, 
+ * or NULL if the threads should not be pinned
+ *
+ * Note: like in ev_pin_process the allowed cpus are assumed to be
+ *       in contiguous blocks per socket / NUMA node
+ */
+static int *ev_thread_cpus(EvInitArgs *args) {
+
+  cpu_set_t allowed;
+  int allowed_cpus[CPU_SETSIZE];
+  int *cpus;
+  int i, n = 0;
+  uint32_t affinity = args->flags & EV_AFFINITY_MASK;
+  uint32_t executor = args->flags & EV_EXECUTOR_MASK;
+
+  /* only our own threads are pinned */
+  if (affinity == EV_AFFINITY_NONE || args->num_threads < 2 ||
+      (executor != EV_EXECUTOR_TCLIENT && 
+       executor != EV_EXECUTOR_POOL    &&
+       executor != EV_EXECUTOR_PTHREAD))
+    return NULL;
+
+  if (affinity != EV_AFFINITY_LIST) {
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) < 0)
+      return NULL;
+
+    for (i = 0; i < CPU_SETSIZE; i++)
+      if (CPU_ISSET(i, &allowed))
+        allowed_cpus[n++] = i;
+
+    if (n == 0)
+      return NULL;
+  }
+
+  cpus = (int *) malloc(sizeof(int) * args->num_threads);
+
+  for (i = 0; i < args->num_threads; i++) {
+    if (affinity == EV_AFFINITY_LIST)
+      cpus[i] = args->cpus[i % args->num_cpus];
+    else if (affinity == EV_AFFINITY_SCATTER)
+      cpus[i] = allowed_cpus[(int) ((int64_t) i * n / 
+                                    args->num_threads) % n];
+    else
+      cpus[i] = allowed_cpus[i % n];
+  }
+
+  return cpus;
+}
+
+/**
+ * Pins the calling thread to the cpu of the given thread args
+ * and moves the (page aligned) thread args to its NUMA node
+ */
+static void ev_pin_thread(EvThreadArgs *evt) {
+
+  cpu_set_t set;
+  unsigned cpu, node;
+  void *page = evt;
+  int target, status;
+
+  CPU_ZERO(&set);
+  CPU_SET(evt->cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+
+  /* fails without NUMA support, the args stay where they are */
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) {
+    target = (int) node;
+    syscall(SYS_move_pages, 0, 1, &page, &target, &status, 0);
+  }
+
+  /* the pthread executor starts new threads each generation */
+  evt->pinned = evt->ev->executor != EV_EXECUTOR_PTHREAD;
+}
+
+/**
+ * Starts num_processes processes for an multi process evolution 
+ * and waits until they are finished
+ */
+int ev_launch_processes(const char *shm_name,
+                        int num_processes,
+                        size_t migrant_size,
+                        int (*run) (int, void *),
+                        void *arg) {
+
+  uint64_t slot_size;
+  size_t size;
+  void *shm;
+  pid_t *pids;
+  int fd, i, status, failed = 0;
+
+  if (shm_name == NULL || num_processes < 1 || migrant_size == 0 || 
+      run == NULL) {
+    DBG_MSG("wrong opts");
+    return -1;
+  }
+
+  /* slots are cache line aligned */
+  slot_size = (sizeof(EvShmSlot) + migrant_size + 63) & ~((uint64_t) 63);
+  size      = ev_shm_size(num_processes, slot_size);
+
+  fd = shm_open(shm_name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    perror("shm_open");
+    return -1;
+  }
+
+  if (ftruncate(fd, size) < 0) {
+    perror("ftruncate");
+    close(fd);
+    shm_unlink(shm_name);
+    return -1;
+  }
+
+  shm = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (shm == MAP_FAILED) {
+    perror("mmap");
+    shm_unlink(shm_name);
+    return -1;
+  }
+
+  /* the rings are zeroed by ftruncate */
+  EV_SHM_HEADER(shm)->num_processes = num_processes;
+  EV_SHM_HEADER(shm)->migrant_size  = migrant_size;
+  EV_SHM_HEADER(shm)->slot_size     = slot_size;
+  __atomic_store_n(&EV_SHM_HEADER(shm)->magic, EV_SHM_MAGIC, __ATOMIC_RELEASE);
+  munmap(shm, size);
+
+  pids = (pid_t *) malloc(sizeof(pid_t) * num_processes);
+
+  /* don't print buffered output twice */
+  fflush(stdout);
+  fflush(stderr);
+
+  for (i = 0; i < num_processes; i++) {
+    pids[i] = fork();
+
+    if (pids[i] == 0) {
+      ev_pin_process(i, num_processes);
+      exit(run(i, arg));
+    }
+
+    if (pids[i] < 0) {
+      perror("fork");
+      failed++;
+    }
+  }
+
+  for (i = 0; i < num_processes; i++) {
+    if (pids[i] > 0 && (waitpid(pids[i], &status, 0) < 0 ||
+                        !WIFEXITED(status) || 
+                        WEXITSTATUS(status) != 0)) {
+      failed++;
+    }
+  }
+
+  free(pids);
+  shm_unlink(shm_name);
+
+  return failed;
+}
+
+/**
+ * Initializes the evolution process
+ * by configurating and starting the threads
+ * and choosing what to be done
+ */
+static inline void init_evolute(Evolution *ev) {
+
+  /**
+   * init recombinatin or mutatation
+   * depeding on given flags in init
+   */
+  if (ev->use_greedy)
+    ev_init_greedy(ev);
+  else if (ev->steady_state)
+    ev_init_steady_state(ev);
+  else if (ev->use_islands)
+    ev_init_islands(ev);
+  else if (ev->use_recombination)
+    ev_init_recombinate(ev);
+  else 
+    ev_init_mutate(ev);
+
+  /* the ranks of the parents are allways the same */
+  if (ev->parent_selection == EV_PARENT_RANK)
+    ev_alias_build(ev);
+}
+
+/**
+ * Called at each generation change: takes a requested snapshot of 
+ * the best individual and returns 0 if the evolution was cancelled
+ * or continue_ev returned 0 (opt are the opts of the calling thread)
+ *
+ * Note: the best individual is not changed at this point
+ */
+static char ev_continue(Evolution *ev, void *opt) {
+
+  EvAsync *async = ev->async;
+
+  if (async != NULL) {
+    __atomic_store_n(&async->best_fitness, 
+                     ev->population[0]->fitness, 
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&async->generations, 
+                     ev->info.generations_progressed, 
+                     __ATOMIC_RELEASE);
+
+    pthread_mutex_lock(&async->lock);
+
+    if (async->snapshot != NULL) {
+      EV_CLONE_IV(ev, async->snapshot->iv, ev->population[0]->iv, opt);
+      async->snapshot->fitness = ev->population[0]->fitness;
+      async->snapshot          = NULL;
+      async->epoch             = ev->info.generations_progressed;
+      pthread_cond_broadcast(&async->served);
+    }
+
+    pthread_mutex_unlock(&async->lock);
+
+    if (__atomic_load_n(&async->cancelled, __ATOMIC_RELAXED))
+      return 0;
+  }
+
+  return !ev->use_abort_requirement || ev->continue_ev(ev);
+}
+
+/**
+ * Finishes the Evolution progresse to some verbose work if neccesary
+ * and returns the best individual
+ */
+static inline Individual *close_evolute(Evolution *ev) {
+
+  /* clear line if neccesary */
+  if (ev->verbose >= EV_VERBOSE_ONELINE)
+    printf("\33[2K\r");
+
+  /* the best individual has to survive the arena */
+  if (ev->arena != NULL) {
+    ev_arena_release_best(ev);
+    return &ev->arena_best;
+  }
+
+  return ev->population[0];
+}
+
+/**
+ * do the actual evolution, which means
+ *  - calculate the fitness for each Individual
+ *  - sort Individual by fitness
+ *  - remove worst ivs
+ *  - grow a new generation
+ *
+ * Retruns the best individual
+ */
+Individual *evolute(Evolution *ev) {
+
+  int i;
+
+  /**
+   * initalize the evolution process
+   */
+  init_evolute(ev);
+
+  /**
+   * print status informations if wanted
+   */
+  if (ev->verbose >= EV_VERBOSE_HIGH && ev->use_greedy)
+    EV_GREEDY_OUTPUT(*ev);
+
+  /**
+   * in steady state mode there are no generation changes,
+   * the threads work untill all generations are done
+   */
+  if (ev->steady_state) {
+    steady_state_ivs(ev);
+    return close_evolute(ev);
+  }
+
+  /**
+   * in async greedy mode the threads only 
+   * exchange their best individuals
+   */
+  if (ev->greedy_async && ev->num_threads > 1) {
+    greedy_async_ivs(ev);
+    return close_evolute(ev);
+  }
+
+  /**
+   * in the island model the threads evolve their own islands 
+   * and are only synchronized to migrate the elites
+   */
+  if (ev->use_islands) {
+    islands_ivs(ev);
+    return close_evolute(ev);
+  }
+
+  /**
+   * Generation loop
+   * each loop lets one generation grow kills the worst individuals
+   * and let new individuals born (depending on the previous given flags)
+   */
+  for (i = 0; 
+       i < ev->generation_limit && ev_continue(ev, *ev->opts); 
+       i++) {
+
+    /* the fitness of the parents changed */
+    if (ev->parent_selection == EV_PARENT_PROPORTIONAL)
+      ev_alias_build(ev);
+
+    /**
+     * recombinates or mutates individuals
+     * depeding on given flags in init
+     */
+    if (ev->num_threads > 1) {
+      if (ev->use_greedy)
+        greedy_ivs(ev);
+      else
+        evolute_ivs(ev);
+    } else {
+      if (ev->use_greedy)
+        greedy_ivs_seriel(ev);
+      else
+        evolute_ivs_seriel(ev);
+    }
+  
+    /**
+     * switch old and new generation to discard the old one
+     * which will be overidden next time
+     */
+    if (!ev->keep_last_generation && !ev->use_greedy)
+      ev_switch_ivs(ev);
+
+    /**
+     * in process mode the migrants of the previous process
+     * compete with the new individuals during the selection
+     */
+    if (ev->use_processes && (i + 1) % ev->migration_interval == 0)
+      ev_shm_import(ev);
+
+    /**
+     * Select the best individuals to survindividuale,
+     * Sort the Individuals by theur fittnes
+     */
+    if (ev->partial_selection)
+      ev_partition(ev, ev->survivors);
+    else if (ev->merge_selection)
+      ev_merge_selection(ev);
+    else if (EV_SORT_FREE(ev))
+      ev_partition(ev, ev->overall_start);
+    else if (!ev->use_greedy)
+      EV_SORT(ev, 1);
+
+    /* the surviving offsprings become parents */
+    if (ev->use_delta)
+      ev_delta_apply(ev, ev->survivors);
+
+    /* send the best individuals to the next process */
+    if (ev->use_processes && (i + 1) % ev->migration_interval == 0)
+      ev_shm_export(ev);
+
+    /* update progressed generations */
+    ev->info.generations_progressed = i + 1;
+
+    /**
+     * print status informations if wanted
+     */
+    if (ev->verbose >= EV_VERBOSE_HIGH && ev->use_greedy)
       EV_GREEDY_OUTPUT(*ev);
     else if (ev->verbose >= EV_VERBOSE_HIGH)
       EV_EVOLUTE_OUTPUT(*ev);
 
   }
 
-  /* shutdown threads */
-  close_evolute(ev);
+  /**
+   * the last parents are not sorted yet (without any generation the
+   * lazy individuals aren't bred, but the initialized ones are sorted)
+   */
+  if ((ev->partial_selection || EV_SORT_FREE(ev)) &&
+      !(ev->lazy_init && i == 0))
+    EV_SORT(ev, 1);
+
+  /* the dead offsprings of the last generation too */
+  if (ev->use_delta)
+    ev_delta_apply(ev, ev->population_size);
+
+  /* shutdown threads */
+  return close_evolute(ev);
+}
+
+
+/**
+ * Thread function wich runs evolute for an EvAsync handle
+ */
+static void *threadable_async(void *arg) {
+
+  EvAsync *async   = arg;
+  Individual *best = evolute(async->ev);
+
+  /* the last snapshot request is served from the result */
+  pthread_mutex_lock(&async->lock);
+  async->best = best;
+  __atomic_store_n(&async->finished, 1, __ATOMIC_RELEASE);
+  pthread_cond_broadcast(&async->served);
+  pthread_mutex_unlock(&async->lock);
+
+  return NULL;
+}
+
+/**
+ * Starts evolute for the given Evolution in a new thread and 
+ * returns a handle to controll it
+ */
+EvAsync *evolute_async(Evolution *ev) {
+
+  EvAsync *async = (EvAsync *) malloc(sizeof(EvAsync));
+
+  async->ev        = ev;
+  async->snapshot  = NULL;
+  async->epoch     = 0;
+  async->best      = NULL;
+  async->finished  = 0;
+  async->generations  = 0;
+  async->best_fitness = ev->population[0]->fitness;
+  async->cancelled = 0;
+  pthread_mutex_init(&async->lock, NULL);
+  pthread_cond_init(&async->served, NULL);
+
+  ev->async = async;
+
+  if (pthread_create(&async->thread, NULL, threadable_async, async) != 0) {
+    DBG_MSG("pthread_create failed");
+
+    ev->async = NULL;
+    pthread_cond_destroy(&async->served);
+    pthread_mutex_destroy(&async->lock);
+    free(async);
+    return NULL;
+  }
+
+  return async;
+}
+
+/**
+ * Returns 1 if the evolution of the given handle is finished
+ */
+char ev_async_poll(EvAsync *async) {
+  return __atomic_load_n(&async->finished, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Waits untill the evolution of the given handle is finished,
+ * frees the handle and returns the best Individual
+ */
+Individual *ev_async_wait(EvAsync *async) {
+
+  Individual *best;
+
+  pthread_join(async->thread, NULL);
+
+  best             = async->best;
+  async->ev->async = NULL;
+
+  pthread_cond_destroy(&async->served);
+  pthread_mutex_destroy(&async->lock);
+  free(async);
+
+  return best;
+}
+
+/**
+ * Stops the evolution of the given handle at the next generation
+ */
+void ev_async_cancel(EvAsync *async) {
+  __atomic_store_n(&async->cancelled, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Clones the best Individual of the running evolution into dst 
+ * and returns the generation it was taken at
+ */
+int ev_async_snapshot_best(EvAsync *async, Individual *dst) {
+
+  Evolution *ev = async->ev;
+  int epoch;
+
+  pthread_mutex_lock(&async->lock);
+
+  /* only one request at a time */
+  while (async->snapshot != NULL && !async->finished)
+    pthread_cond_wait(&async->served, &async->lock);
+
+  if (!async->finished) {
+    async->snapshot = dst;
+
+    while (async->snapshot == dst && !async->finished)
+      pthread_cond_wait(&async->served, &async->lock);
+  }
+
+  /* the evolution finished before serving the request */
+  if (async->finished) {
+    async->snapshot = NULL;
+    EV_CLONE_IV(ev, dst->iv, async->best->iv, *ev->opts);
+    dst->fitness    = async->best->fitness;
+    async->epoch    = ev->info.generations_progressed;
+  }
+
+  epoch = async->epoch;
+  pthread_mutex_unlock(&async->lock);
+
+  return epoch;
+}
+
+/**
+ * Runs num_runs evolutions at the same time on one pool 
+ * of num_threads threads, cancels the runs wich are behind
+ * and returns the best Individual of all runs
+ */
+Individual ev_portfolio(EvInitArgs *args, 
+                        int num_runs, 
+                        int num_threads, 
+                        int check_ms,
+                        double tolerance) {
+
+  EvPool *pool;
+  Evolution **evs;
+  EvAsync **asyncs;
+  char *alive;
+  EvInitArgs *runs;
+  Individual best, *result;
+  int i, running, leader, best_run = -1;
+  int64_t fitness, lead, margin;
+  double scaled;
+
+  best.iv      = NULL;
+  best.fitness = 0;
+
+  if (args == NULL || num_runs < 1 || num_threads < 1 || check_ms < 1) {
+    DBG_MSG("wrong opts");
+    return best;
+  }
+
+  /* a negative or NaN tolerance cancels every run behind the leader */
+  if (!(tolerance > 0))
+    tolerance = 0;
+
+  pool   = new_ev_pool(num_threads);
+  evs    = (Evolution **) malloc(sizeof(Evolution *) * num_runs);
+  asyncs = (EvAsync **) malloc(sizeof(EvAsync *) * num_runs);
+  alive  = (char *) malloc(num_runs);
+  runs   = (EvInitArgs *) malloc(sizeof(EvInitArgs) * num_runs);
+
+  /* the args of the caller stay untouched */
+  for (i = 0; i < num_runs; i++) {
+    runs[i]       = args[i];
+    runs[i].pool  = pool;
+    runs[i].flags = (runs[i].flags & ~EV_EXECUTOR_MASK) | EV_EXECUTOR_SHARED;
+
+    evs[i]    = new_evolution(&runs[i]);
+    asyncs[i] = evs[i] != NULL ? evolute_async(evs[i]) : NULL;
+    alive[i]  = asyncs[i] != NULL;
+  }
+
+  for (running = 1; running; ) {
+    usleep(check_ms * 1000);
+
+    /* find the leader of the runs with at least one generation */
+    running = 0;
+    leader  = -1;
+    for (i = 0; i < num_runs; i++) {
+      if (!alive[i] || ev_async_poll(asyncs[i]))
+        continue;
+
+      running++;
+      if (__atomic_load_n(&asyncs[i]->generations, __ATOMIC_ACQUIRE) > 0 &&
+          (leader < 0 || 
+           EV_BETTER(evs[i], 
+                     __atomic_load_n(&asyncs[i]->best_fitness, 
+                                     __ATOMIC_RELAXED),
+                     __atomic_load_n(&asyncs[leader]->best_fitness, 
+                                     __ATOMIC_RELAXED))))
+        leader = i;
+    }
+
+    if (leader < 0 || running < 2)
+      continue;
+
+    lead   = __atomic_load_n(&asyncs[leader]->best_fitness, __ATOMIC_RELAXED);
+    scaled = tolerance * ((double) lead < 0 ? -(double) lead : (double) lead);
+    margin = scaled < (double) INT64_MAX ? (int64_t) scaled : INT64_MAX;
+
+    /* cancel the runs wich are clearly behind */
+    for (i = 0; i < num_runs; i++) {
+      if (!alive[i] || i == leader || 
+          __atomic_load_n(&asyncs[i]->generations, __ATOMIC_ACQUIRE) == 0)
+        continue;
+
+      /* shift the fitness by the margin without overflowing */
+      fitness = __atomic_load_n(&asyncs[i]->best_fitness, __ATOMIC_RELAXED);
+      if (evs[i]->sort_max)
+        fitness = fitness > INT64_MAX - margin ? INT64_MAX : fitness + margin;
+      else
+        fitness = fitness < INT64_MIN + margin ? INT64_MIN : fitness - margin;
+
+      if (EV_BETTER(evs[i], lead, fitness)) {
+        ev_async_cancel(asyncs[i]);
+        alive[i] = 0;
+      }
+    }
+  }
+
+  /* collect the results and keep the best one */
+  for (i = 0; i < num_runs; i++) {
+    if (asyncs[i] == NULL) {
+      if (evs[i] != NULL) {
+        evolution_clean_up(evs[i]);
+        free(evs[i]);
+      }
+      continue;
+    }
+
+    result = ev_async_wait(asyncs[i]);
+
+    if (best_run < 0 || EV_BETTER(evs[i], result->fitness, best.fitness)) {
+      if (best_run >= 0)
+        EV_ARGS_FREE_IV(&runs[best_run], best.iv, runs[best_run].opts[0]);
+
+      best     = *result;
+      best_run = i;
+    } else
+      EV_ARGS_FREE_IV(&runs[i], result->iv, runs[i].opts[0]);
+
+    evolution_clean_up(evs[i]);
+    free(evs[i]);
+  }
+
+  ev_pool_free(pool);
+  free(evs);
+  free(asyncs);
+  free(alive);
+  free(runs);
+
+  return best;
+}
+
+/**
+ * Runs a short evolution with the given args and returns 
+ * the nanoseconds per generation (UINT64_MAX if the args are invalid)
+ */
+static uint64_t ev_calibrate(EvInitArgs *args) {
+
+  EvInitArgs targs = *args;
+  Evolution *ev    = new_evolution(&targs);
+  Individual best;
+  uint64_t start, elapsed;
+  int generations;
+
+  if (ev == NULL)
+    return UINT64_MAX;
+
+  start       = ev_time_ns();
+  best        = *evolute(ev);
+  elapsed     = ev_time_ns() - start;
+  generations = ev->info.generations_progressed;
+
+  EV_ARGS_FREE_IV(&targs, best.iv, targs.opts[0]);
+  evolution_clean_up(ev);
+  free(ev);
+
+  return elapsed / (generations > 0 ? generations : 1);
+}
+
+/**
+ * Returns the signature of the given args (and key) 
+ * under wich the tuned settings are cached
+ */
+static uint64_t ev_tune_signature(EvInitArgs *args, const char *key) {
+
+  /* the tuned flags and the verbosity don't change the work */
+  uint32_t flags = args->flags & ~(EV_EXECUTOR_MASK | EV_TUNE |
+                                   EV_VEB1 | EV_VEB2 | EV_VEB3);
+  /* the greedy values are only set with EV_GRDY */
+  char greedy = (args->flags & EV_GRDY) != 0;
+  int64_t values[] = { 
+    args->population_size, 
+    greedy ? args->greedy_size : 0, 
+    greedy ? args->greedy_individuals : 0,
+    (int64_t) (args->mutation_propability * 1e6), 
+    (int64_t) (args->death_percentage * 1e6),
+    args->num_threads, 
+    flags, 
+    sysconf(_SC_NPROCESSORS_ONLN) 
+  };
+  const unsigned char *bytes = (const unsigned char *) values;
+  uint64_t hash = 14695981039346656037ULL;
+  size_t i;
+
+  /* FNV-1a over the values and the key */
+  for (i = 0; i < sizeof(values); i++)
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+
+  for (i = 0; key != NULL && key[i] != '\0'; i++)
+    hash = (hash ^ (unsigned char) key[i]) * 1099511628211ULL;
+
+  return hash;
+}
+
+/**
+ * Tunes num_threads, the executor, chunks_per_thread, min_quicksort and
+ * min_radix of the given args by running short evolutions with each setting
+ * and writes back the fastest settings (see evolution.h)
+ */
+int ev_autotune(EvInitArgs *args, 
+                int generations, 
+                const char *cache, 
+                const char *key) {
+
+  static const uint32_t executors[] = { EV_EXECUTOR_TCLIENT, 
+                                        EV_EXECUTOR_POOL, 
+                                        EV_EXECUTOR_PTHREAD };
+  static const int chunks[]         = { 1, 2, 4, 8, 16, 32 };
+  static const int min_sorts[]      = { 8, 12, 16, 20, 32, 48, 64 };
+  static const int min_radixes[]    = { 1, INT_MAX };
+
+  EvInitArgs base, targs;
+  uint64_t signature, best_ns, ns;
+  unsigned long long csignature;
+  unsigned cexecutor;
+  int cthreads, cchunks, csort, cradix;
+  int threads, min_threads, i;
+  FILE *file;
+
+  if (generations < 1 || args->num_threads < 1 ||
+      args->flags & EV_PROC ||
+      (args->flags & EV_EXECUTOR_MASK) == EV_EXECUTOR_SHARED) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  /* the number of threads is limited by the opts */
+  min_threads = (args->flags & EV_ISLE) ? 2 : 1;
+  if (args->num_threads < min_threads) {
+
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+
+  signature = ev_tune_signature(args, key);
+  cexecutor = EV_EXECUTOR_TCLIENT;
+
+  /* look for the settings of an earlier run */
+  if (cache != NULL && (file = fopen(cache, "r")) != NULL) {
+    while (fscanf(file, 
+                  "%llx %d %u %d %d %d", 
+                  &csignature, 
+                  &cthreads, 
+                  &cexecutor, 
+                  &cchunks, 
+                  &csort,
+                  &cradix) == 6) {
+
+      if (csignature == signature && 
+          cthreads >= min_threads && cthreads <= args->num_threads &&
+          (cexecutor & ~EV_EXECUTOR_MASK) == 0 && 
+          cexecutor < EV_EXECUTOR_SHARED && cchunks > 0 && csort > 0 &&
+          cradix > 0) {
+
+        fclose(file);
+        args->num_threads       = cthreads;
+        args->flags             = (args->flags & ~EV_EXECUTOR_MASK) | 
+                                  cexecutor | EV_TUNE;
+        args->chunks_per_thread = cchunks;
+        args->min_quicksort     = csort;
+        args->min_radix         = cradix;
+        return 1;
+      }
+    }
+    fclose(file);
+  }
+
+  /* the test runs do the same work in each generation */
+  base                   = *args;
+  base.generation_limit  = generations;
+  base.flags            &= ~(EV_ABRT | EV_VEB1 | EV_VEB2 | EV_VEB3);
+  base.flags            |= EV_TUNE;
+  base.chunks_per_thread = EV_CHUNKS_PER_THREAD;
+  base.min_quicksort     = EV_QICKSORT_MIN;
+  base.min_radix         = EV_RADIX_MIN;
+  best_ns                = UINT64_MAX;
+
+  /* the number of threads (doubled up to the maximum) and the executor */
+  for (threads = min_threads; ; threads *= 2) {
+    if (threads > args->num_threads)
+      threads = args->num_threads;
+
+    for (i = 0; i < (threads > 1 ? 3 : 1); i++) {
+      targs             = base;
+      targs.num_threads = threads;
+      targs.flags       = (base.flags & ~EV_EXECUTOR_MASK) | executors[i];
+      
+      if ((ns = ev_calibrate(&targs)) < best_ns) {
+        best_ns          = ns;
+        base.num_threads = threads;
+        cexecutor        = executors[i];
+      }
+    }
+
+    if (threads == args->num_threads)
+      break;
+  }
+
+  if (best_ns == UINT64_MAX) {
+    DBG_MSG("wrong opts");
+    return 0;
+  }
+  base.flags = (base.flags & ~EV_EXECUTOR_MASK) | cexecutor;
+
+  /* the chunk size only matters with more than one thread */
+  for (i = 0; base.num_threads > 1 && i < 6; i++) {
+    targs                   = base;
+    targs.chunks_per_thread = chunks[i];
+
+    if (chunks[i] != base.chunks_per_thread && 
+        (ns = ev_calibrate(&targs)) < best_ns) {
+      best_ns                = ns;
+      base.chunks_per_thread = chunks[i];
+    }
+  }
+
+  for (i = 0; i < 7; i++) {
+    targs               = base;
+    targs.min_quicksort = min_sorts[i];
+
+    if (min_sorts[i] != base.min_quicksort && 
+        (ns = ev_calibrate(&targs)) < best_ns) {
+      best_ns            = ns;
+      base.min_quicksort = min_sorts[i];
+    }
+  }
+
+  /* allways or never the radix sort (depends on the population size) */
+  for (i = 0; i < 2; i++) {
+    targs           = base;
+    targs.min_radix = min_radixes[i];
+
+    if ((ns = ev_calibrate(&targs)) < best_ns) {
+      best_ns        = ns;
+      base.min_radix = min_radixes[i];
+    }
+  }
+
+  args->num_threads       = base.num_threads;
+  args->flags             = (args->flags & ~EV_EXECUTOR_MASK) | 
+                            cexecutor | EV_TUNE;
+  args->chunks_per_thread = base.chunks_per_thread;
+  args->min_quicksort     = base.min_quicksort;
+  args->min_radix         = base.min_radix;
+
+  if (args->flags & (EV_VEB1 | EV_VEB2 | EV_VEB3))
+    printf("tuned: num_threads %d, executor %u, chunks_per_thread %d, "
+           "min_quicksort %d, min_radix %d (%llu ns per generation)\n",
+           args->num_threads, 
+           cexecutor, 
+           args->chunks_per_thread, 
+           args->min_quicksort, 
+           args->min_radix, 
+           (unsigned long long) best_ns);
+
+  if (cache != NULL && (file = fopen(cache, "a")) != NULL) {
+    fprintf(file, 
+            "%016llx %d %u %d %d %d\n", 
+            (unsigned long long) signature, 
+            args->num_threads, 
+            cexecutor, 
+            args->chunks_per_thread, 
+            args->min_quicksort,
+            args->min_radix);
+    fclose(file);
+  }
+
+  return 1;
+}
+
+/**
+ * Recombinates two random individuals out of the parents 
+ * [base, base + n) into the individual at index j, mutates it
+ * depending on the flags and calculates its fitness.
+ * Returns 1 if the new individual is better than both parents
+ * (in async fitness mode the number of completed individuals
+ * wich are better than their parents)
+ */
+static int ev_recombinate_at(Evolution *ev, 
+                             int j, 
+                             int base, 
+                             int n, 
+                             rand128_t *v_rand, 
+                             void *opt,
+                             EvThreadArgs *evt) {
+
+  int rand1, rand2;
+  Individual **parents = ev->population;
+
+  /**
+   * from two randomly choosen Individuals 
+   * of the untouched (best) part we calculate an new one 
+   * */
+  rand1 = ev_pick_parent(ev, base, n, v_rand);
+  rand2 = ev_pick_second_parent(ev, rand1, base, n, v_rand);
+
+  EV_LAZY_IV_AT(ev, j, opt);
+  
+  /* recombinate individuals */
+  ev->recombinate(parents[rand1], 
+                  parents[rand2], 
+                  ev->population[j], 
+                  opt);
+  
+  /* mutate Individuals */
+  if (ev->use_muttation) {
+    if (ev->always_mutate)
+      ev->mutate(ev->population[j], opt);
+    else {
+      if (rand128(v_rand) <= ev->i_mut_propability)
+        ev->mutate(ev->population[j], opt);
+    }
+  }
+
+  /**
+   * calculate the fittnes for the new individuals and store if 
+   * it is better as the old ones (as the better of both)
+   */
+  return ev_fitness_at(ev, 
+                       j, 
+                       EV_BETTER(ev, 
+                                 parents[rand1]->fitness, 
+                                 parents[rand2]->fitness) ? 
+                       parents[rand1]->fitness : parents[rand2]->fitness,
+                       opt, 
+                       evt);
+}
+
+/**
+ * Clones the individual at index src into the individual 
+ * at index j, mutates it and calculates its fitness.
+ * Returns 1 if the new individual is better than the old one
+ * (in async fitness mode the number of completed individuals
+ * wich are better than their parents)
+ */
+static int ev_mutate_at(Evolution *ev, 
+                        int j, 
+                        int src, 
+                        void *opt, 
+                        EvThreadArgs *evt) {
+
+  Individual *parent = ev->population[src];
+  Individual *child;
+  int k;
+
+  /* only record the mutation, the clone is made if it survives */
+  if (ev->use_delta) {
+    child                = ev->population[j];
+    k                    = (int) (child - ev->ivs);
+    ev->delta_parents[k] = parent;
+
+    ev->mutate_delta(parent, EV_DELTA_AT(ev, k), opt);
+    child->fitness = ev->fitness_delta(parent, EV_DELTA_AT(ev, k), opt);
+
+    return EV_BETTER(ev, child->fitness, parent->fitness);
+  }
+
+  EV_LAZY_IV_AT(ev, j, opt);
+
+  /**
+   * clone the individual (from the survivors)
+   * and override an individual in the deaths-part
+   */
+  EV_CLONE_IV(ev, ev->population[j]->iv, 
+                  parent->iv, 
+                  opt);
+
+  /* muttate the cloned individual */
+  ev->mutate(ev->population[j], opt);
+
+  /**
+   * calculate the fittnes for the new individual 
+   * and store if it is better as the old one
+   */
+  return ev_fitness_at(ev, j, parent->fitness, opt, evt);
+}
+
+/**
+ * Calculates the fitness of the individual at index j, or submits it
+ * in async fitness mode (if evt is not NULL).
+ * Returns the number of individuals better than their bound, 
+ * wich were completed during this call
+ */
+static int ev_fitness_at(Evolution *ev, 
+                         int j, 
+                         int64_t bound, 
+                         void *opt, 
+                         EvThreadArgs *evt) {
+
+  int improovs = 0, better;
+
+  if (!ev->async_fitness || evt == NULL) {
+    EV_CALC_FITNESS_AT(ev, j, opt);
+    return EV_BETTER(ev, EV_FITNESS_AT(ev, j), bound);
+  }
+
+  ev->submit_fitness(ev->population[j], opt);
+  evt->in_flight[evt->num_in_flight].iv    = ev->population[j];
+  evt->in_flight[evt->num_in_flight].bound = bound;
+  evt->num_in_flight++;
+
+  /* collect the finished ones without waiting */
+  while ((better = ev_complete_fitness(ev, evt, 0)) >= 0)
+    improovs += better;
+
+  /* wait untill there is space for the next one */
+  while (evt->num_in_flight >= ev->max_in_flight)
+    improovs += ev_complete_fitness(ev, evt, 1);
+
+  return improovs;
+}
+
+/**
+ * Completes one submitted individual of the given thread
+ * (waits for it if wait is set) and returns 1 if it is
+ * better than its bound, 0 otherwise or -1 if none was completed
+ * (never if wait is set and individuals are in flight)
+ */
+static int ev_complete_fitness(Evolution *ev, EvThreadArgs *evt, char wait) {
+
+  Individual *iv;
+  int i;
+
+  if (evt->num_in_flight == 0)
+    return -1;
+
+  iv = ev->complete_fitness(wait, evt->opt);
+
+  /* waiting again wouldn't complete anything either */
+  if (iv == NULL && wait) {
+    ERR_MSG("complete_fitness returned NULL while waiting");
+    abort();
+  }
+
+  if (iv == NULL)
+    return -1;
+
+  for (i = 0; i < evt->num_in_flight; i++) {
+    if (evt->in_flight[i].iv == iv) {
+      char better = EV_BETTER(ev, iv->fitness, evt->in_flight[i].bound);
+      evt->in_flight[i] = evt->in_flight[--evt->num_in_flight];
+      return better;
+    }
+  }
+
+  /* the submitted ones would never be completed */
+  ERR_MSG("completed individual was not submitted");
+  abort();
+}
+
+/**
+ * Waits untill all individuals submitted by the given thread are
+ * completed, returns the number of them wich are better than their bound
+ */
+static int ev_drain_fitness(Evolution *ev, EvThreadArgs *evt) {
+
+  int improovs = 0;
+
+  while (evt->num_in_flight > 0)
+    improovs += ev_complete_fitness(ev, evt, 1);
+
+  return improovs;
+}
+
+/**
+ * Parallel recombinate
+ */
+static void *threadable_recombinate(void *arg) {
+
+  EvThreadArgs *evt = arg;
+  Evolution *ev     = evt->ev;
+  int j, start, end;
+  rand128_t *v_rand = evt->ev->rands[evt->index];
+
+  /**
+   * for recombination there musst be min two individuals
+   */
+  #ifdef DEBUG
+  if (ev->survivors <= 1)
+    ERR_MSG("less than 2 individuals in recombinate");
+  #endif
+
+  /* reset threadwide iprooves */
+  evt->improovs = 0;  
+
+  /**
+   * loop untill no chunk is left, neither in our own slice
+   * nor in the slices of the other threads
+   */
+  while (ev_next_chunk(evt, &start, &end)) {
+    for (j = start; j < end; j++) {
+
+      evt->improovs += ev_recombinate_at(ev, 
+                                         j, 
+                                         0, 
+                                         ev->overall_start, 
+                                         v_rand, 
+                                         evt->opt,
+                                         evt);
+
+      /**
+       * print status informations if wanted
+       */
+      if (ev->verbose >= EV_VERBOSE_ONELINE) {
+        EV_IV_STATUS_OUTPUT(*ev, j);
+
+        if (ev->verbose >= EV_VERBOSE_ULTRA)
+          EV_THREAD_SAVE_NEW_LINE(*ev);
+      }
+    }
+  }
+
+  /* the selection needs all fitness values */
+  evt->improovs += ev_drain_fitness(ev, evt);
+
+  return NULL;
+}
+
+/**
+ * Thread function to do mutation onely
+ * if number of survivors == number of deaths
+ */
+static void *threadable_mutation_onely_1half(void *arg) {
+
+  EvThreadArgs *evt = arg;
+  Evolution *ev     = evt->ev;
+  int j, start, end;
+  
+  /* reset threadwide iprooves */
+  evt->improovs = 0;  
+ 
+  /**
+   * loop untill no chunk is left, neither in our own slice
+   * nor in the slices of the other threads
+   */
+  while (ev_next_chunk(evt, &start, &end)) {
+    for (j = start; j < end; j++) {
+ 
+      /**
+       * clone the current individual (from the survivors)
+       * and override an individual in the deaths-part
+       */
+      evt->improovs += ev_mutate_at(ev, 
+                                    j, 
+                                    j - ev->overall_start, 
+                                    evt->opt, 
+                                    evt);
+    
+      /**
+       * print status informations if wanted
+       */
+      if (ev->verbose >= EV_VERBOSE_ONELINE) {
+        EV_IV_STATUS_OUTPUT(*ev, j);
+ 
+        if (ev->verbose >= EV_VERBOSE_ULTRA)
+          EV_THREAD_SAVE_NEW_LINE(*ev);
+      }
+    }
+  }
+
+  /* the selection needs all fitness values */
+  evt->improovs += ev_drain_fitness(ev, evt);
+
+  return NULL;
+}
+
+/**
+ * Thread function to do mutation onely
+ * if numbers of survivors != number of deaths
+ */
+static void *threadable_mutation_onely_rand(void *arg) {
+
+  EvThreadArgs *evt = arg;
+  Evolution *ev = evt->ev;
+  int j, start, end;
+  rand128_t *v_rand = evt->ev->rands[evt->index];
+
+  /* reset threadwide iprooves */
+  evt->improovs = 0;  
+ 
+  /**
+   * loop untill no chunk is left, neither in our own slice
+   * nor in the slices of the other threads
+   */
+  while (ev_next_chunk(evt, &start, &end)) {
+    for (j = start; j < end; j++) {
+ 
+      /**
+       * clone random individual (from the survivors)
+       * and override the current individual in the deaths-part
+       */
+      evt->improovs += ev_mutate_at(ev, 
+                                    j, 
+                                    ev_pick_parent(ev, 
+                                                   0, 
+                                                   ev->overall_start, 
+                                                   v_rand), 
+                                    evt->opt,
+                                    evt);
+   
+      /**
+       * print status informations if wanted
+       */
+      if (ev->verbose >= EV_VERBOSE_ONELINE) {
+        EV_IV_STATUS_OUTPUT(*ev, j);
+ 
+        if (ev->verbose >= EV_VERBOSE_ULTRA)
+          EV_THREAD_SAVE_NEW_LINE(*ev);
+      }
+    }
+  }
+
+  /* the selection needs all fitness values */
+  evt->improovs += ev_drain_fitness(ev, evt);
+
+  return NULL;
+}
+
+/**
+ * Thread function to do greedy 
+ */
+static void *threadable_greedy(void *arg) {
+
+  EvThreadArgs *evt = arg;
+  Evolution *ev = evt->ev;
+  int j, start = evt->start;
+
+  /* reset threadwide iprooves */
+  evt->improovs = 0;  
+ 
+  /* initialize generation best to greedy best */
+  EV_CLONE_IV(ev, ev->population[start + 1]->iv, ev->population[start]->iv, evt->opt);
+  ev->population[start + 1]->fitness = ev->population[start]->fitness;
+
+  /* the working copy is only reverted after each candidate */
+  if (ev->use_undo)
+    EV_CLONE_IV(ev, ev->population[start + 2]->iv, ev->population[start]->iv, evt->opt);
+
+  for (j = 0; j < ev->greedy_size; j++) {
+
+    /* copy greedy best and mutate it */
+    if (ev->use_undo) {
+      ev->mutate_undoable(ev->population[start + 2], 
+                          EV_UNDO_AT(ev, evt->index), 
+                          evt->opt);
+    } else {
+      EV_CLONE_IV(ev, ev->population[start + 2]->iv, ev->population[start]->iv, evt->opt);
+      ev->mutate(ev->population[start + 2], evt->opt);
+    }
+
+    /* calculate fitness and set generation best if neccesary */
+    EV_CALC_FITNESS_AT(ev, start + 2, evt->opt);
+    
+    EV_COPY_GREEDY_COUNT(ev, start + 1, start + 2, evt->opt, evt->improovs);
+
+    /* revert the working copy to the greedy best */
+    if (ev->use_undo)
+      ev->undo(ev->population[start + 2], EV_UNDO_AT(ev, evt->index), evt->opt);
+
+    /**
+     * print status informations if wanted
+     */
+    if (ev->verbose >= EV_VERBOSE_ONELINE) {
+      EV_IV_GREEDY_STATUS_OUTPUT(*ev, j);
+
+      if (ev->verbose >= EV_VERBOSE_ULTRA)
+        EV_THREAD_SAVE_NEW_LINE(*ev);
+    }
+  }
+
+  /* set greedy best if generation best is better */
+  EV_COPY_GREEDY(ev, start, start + 1, evt->opt);
+
+  return NULL;
+}
+
+/**
+ * Thread function to do greedy without synchronization,
+ * runs rounds untill all generations are done
+ *
+ * Note: only the owner writes its greedy best (at start) and only 
+ *       while holding its lock, the other threads read it under the 
+ *       lock, so the owner can read it without locking
+ */
+static void *threadable_greedy_async(void *arg) {
+
+  EvThreadArgs *evt = arg;
+  Evolution *ev     = evt->ev;
+  int j, start      = evt->start;
+  int64_t round;
+  int64_t limit     = (int64_t) ev->generation_limit * ev->num_threads;
+
+  while (!__atomic_load_n(&ev->greedy_stop, __ATOMIC_RELAXED)) {
+
+    round = __atomic_fetch_add(&ev->greedy_rounds, 1, __ATOMIC_RELAXED);
+    if (round >= limit)
+      break;
+
+    /* reset threadwide iprooves */
+    evt->improovs = 0;  
+
+    /* continue from the best of all threads if it changed */
+    ev_greedy_adopt(ev, evt);
+
+    /* initialize round best to greedy best */
+    EV_CLONE_IV(ev, ev->population[start + 1]->iv, 
+                    ev->population[start]->iv, 
+                    evt->opt);
+    ev->population[start + 1]->fitness = ev->population[start]->fitness;
+
+    /* the working copy is only reverted after each candidate */
+    if (ev->use_undo)
+      EV_CLONE_IV(ev, ev->population[start + 2]->iv, 
+                      ev->population[start]->iv, 
+                      evt->opt);
+
+    for (j = 0; j < ev->greedy_size; j++) {
+
+      /* copy greedy best and mutate it */
+      if (ev->use_undo) {
+        ev->mutate_undoable(ev->population[start + 2], 
+                            EV_UNDO_AT(ev, evt->index), 
+                            evt->opt);
+      } else {
+        EV_CLONE_IV(ev, ev->population[start + 2]->iv, 
+                        ev->population[start]->iv, 
+                        evt->opt);
+        ev->mutate(ev->population[start + 2], evt->opt);
+      }
+
+      /* calculate fitness and set round best if neccesary */
+      EV_CALC_FITNESS_AT(ev, start + 2, evt->opt);
+      
+      EV_COPY_GREEDY_COUNT(ev, start + 1, start + 2, evt->opt, evt->improovs);
+
+      /* revert the working copy to the greedy best */
+      if (ev->use_undo)
+        ev->undo(ev->population[start + 2], 
+                 EV_UNDO_AT(ev, evt->index), 
+                 evt->opt);
+
+      /**
+       * print status informations if wanted
+       */
+      if (ev->verbose >= EV_VERBOSE_ONELINE) {
+        EV_IV_GREEDY_STATUS_OUTPUT(*ev, j);
+
+        if (ev->verbose >= EV_VERBOSE_ULTRA)
+          EV_THREAD_SAVE_NEW_LINE(*ev);
+      }
+    }
+
+    /* set and publish greedy best if round best is better */
+    if (EV_BETTER(ev, EV_FITNESS_AT(ev, start + 1), 
+                      EV_FITNESS_AT(ev, start))) {
+
+      pthread_mutex_lock(&evt->lock);
+      EV_COPY_GREEDY(ev, start, start + 1, evt->opt);
+      pthread_mutex_unlock(&evt->lock);
+
+      ev_greedy_publish(ev, evt);
+    }
+
+    __atomic_fetch_add(&ev->greedy_improovs, evt->improovs, __ATOMIC_RELAXED);
+
+    /* all threads together did one generation */
+    if ((round + 1) % ev->num_threads == 0)
+      ev_greedy_generation(ev, (round + 1) / ev->num_threads, evt->opt);
+  }
+
+  return NULL;
+}
+
+/**
+ * Adopts the published best greedy individual 
+ * if it is better and its owner isn't updating it
+ */
+static void ev_greedy_adopt(Evolution *ev, EvThreadArgs *evt) {
+
+  uint64_t version = __atomic_load_n(&ev->greedy_version, __ATOMIC_ACQUIRE);
+  int owner, src, start = evt->start;
+  EvThreadArgs *owner_args;
+
+  if (version == evt->greedy_seen)
+    return;
+
+  /* the owner belongs to this version */
+  pthread_mutex_lock(&ev->greedy_lock);
+  version = ev->greedy_version;
+  owner   = ev->greedy_owner;
+  pthread_mutex_unlock(&ev->greedy_lock);
+
+  if (owner == evt->index) {
+    evt->greedy_seen = version;
+    return;
+  }
+
+  owner_args = ev->thread_args[owner];
+  src        = owner_args->start;
+
+  /* the owner is just updating it, try again next round */
+  if (pthread_mutex_trylock(&owner_args->lock) != 0)
+    return;
+
+  /**
+   * our own lock is only taken without waiting too, 
+   * otherwise two threads adopting each others best could deadlock
+   */
+  if (EV_BETTER(ev, EV_FITNESS_AT(ev, src), EV_FITNESS_AT(ev, start))) {
+    if (pthread_mutex_trylock(&evt->lock) != 0) {
+      pthread_mutex_unlock(&owner_args->lock);
+      return;
+    }
+
+    EV_CLONE_IV(ev, ev->population[start]->iv, 
+                    ev->population[src]->iv, 
+                    evt->opt);
+    EV_FITNESS_AT(ev, start) = EV_FITNESS_AT(ev, src);
+    pthread_mutex_unlock(&evt->lock);
+  }
+
+  pthread_mutex_unlock(&owner_args->lock);
+  evt->greedy_seen = version;
+}
+
+/**
+ * Publishes the greedy best of the given thread 
+ * if it is better than the published one
+ *
+ * Note: fitness and owner are not updated together, so the owner 
+ *       may have a worse best for a moment, wich is checked when
+ *       adopting it
+ */
+static void ev_greedy_publish(Evolution *ev, EvThreadArgs *evt) {
+
+  int64_t fitness = EV_FITNESS_AT(ev, evt->start);
+
+  /* most rounds don't beat the published best */
+  if (!EV_BETTER(ev, fitness, __atomic_load_n(&ev->greedy_fitness, 
+                                              __ATOMIC_RELAXED))) {
+    return;
+  }
+
+  /* fitness and owner are only published together */
+  pthread_mutex_lock(&ev->greedy_lock);
+
+  if (EV_BETTER(ev, fitness, ev->greedy_fitness)) {
+    __atomic_store_n(&ev->greedy_fitness, fitness, __ATOMIC_RELAXED);
+    ev->greedy_owner = evt->index;
+    __atomic_store_n(&ev->greedy_version, 
+                     ev->greedy_version + 1, 
+                     __ATOMIC_RELEASE);
+
+    evt->greedy_seen = ev->greedy_version;
+  }
+
+  pthread_mutex_unlock(&ev->greedy_lock);
+}
+
+/**
+ * Called each time all threads together did num_threads rounds in
+ * async greedy mode, updates the EvolutionInfo and calls continue_ev
+ *
+ * Note: population[0] is the greedy best of the first thread,
+ *       so its lock is held during continue_ev
+ */
+static void ev_greedy_generation(Evolution *ev, int generation, void *opt) {
+
+  pthread_mutex_lock(&ev->mutex);
+  pthread_mutex_lock(&ev->thread_args[0]->lock);
+
+  /* update progressed generations */
+  if (generation > ev->info.generations_progressed)
+    ev->info.generations_progressed = generation;
+
+  ev->info.improovs = __atomic_exchange_n(&ev->greedy_improovs, 0, 
+                                          __ATOMIC_RELAXED);
+
+  if (!ev_continue(ev, opt))
+    __atomic_store_n(&ev->greedy_stop, 1, __ATOMIC_RELAXED);
+
+  /**
+   * print status informations if wanted
+   */
+  if (ev->verbose >= EV_VERBOSE_HIGH)
+    EV_GREEDY_OUTPUT(*ev);
+
+  pthread_mutex_unlock(&ev->thread_args[0]->lock);
+  pthread_mutex_unlock(&ev->mutex);
+}
+
+/**
+ * Thread function to evolve one island:
+ * sort the island, replace its worst individuals by new ones
+ * and repeat this for island_generations generations
+ */
+static void *threadable_island(void *arg) {
+
+  EvThreadArgs *evt = arg;
+  Evolution *ev     = evt->ev;
+  rand128_t *v_rand = ev->rands[evt->index];
+  int size          = evt->end - evt->start;
+  int deaths        = (int) ((double) size * ev->death_percentage);
+  int survivors     = size - deaths;
+  int i, j;
+
+  /* reset threadwide iprooves */
+  evt->improovs = 0;  
+
+  for (i = 0; i < ev->island_generations; i++) {
+
+    /**
+     * Select the best individuals of the island to survive
+     * (the island can be unsorted after a migration)
+     */
+    EV_SELECTION_AT(ev, evt->start, size);
+
+    /**
+     * grow a new generation, the survivors 
+     * are the first individuals of the island
+     */
+    for (j = evt->start + survivors; j < evt->end; j++) {
+
+      if (ev->use_recombination) {
+        evt->improovs += ev_recombinate_at(ev, 
+                                           j, 
+                                           evt->start, 
+                                           survivors, 
+                                           v_rand, 
+                                           evt->opt,
+                                           evt);
+      } else if (deaths == survivors) {
+        evt->improovs += ev_mutate_at(ev, j, j - survivors, evt->opt, evt);
+      } else {
+        evt->improovs += ev_mutate_at(ev, 
+                                      j, 
+                                      evt->start + 
+                                      rand128(v_rand) % survivors, 
+                                      evt->opt,
+                                      evt);
+      }
+    }
+
+    /* the next selection needs all fitness values */
+    evt->improovs += ev_drain_fitness(ev, evt);
+  }
+
+  /* sort the island for the migration */
+  EV_SELECTION_AT(ev, evt->start, size);
 
-  return ev->population[0];
+  return NULL;
 }
 
-
 /**
- * Parallel recombinate
+ * Thread function wich measures the time of the generation work
  */
-static void *threadable_recombinate(void *arg) {
+static void *threadable_timed(void *arg) {
 
   EvThreadArgs *evt = arg;
-  Evolution *ev     = evt->ev;
-  int j, rand1, rand2;
-  rand128_t *v_rand = evt->ev->rands[evt->index];
 
-  /**
-   * for recombination there musst be min two individuals
-   */
-  #ifdef DEBUG
-  if (ev->survivors <= 1)
-    ERR_MSG("less than 2 individuals in recombinate");
-  #endif
+  if (evt->cpu >= 0 && !evt->pinned)
+    ev_pin_thread(evt);
 
-  /* reset threadwide iprooves */
-  evt->improovs = 0;  
+  evt->start_ns  = ev_time_ns();
+  evt->func(arg);
+  evt->finish_ns = ev_time_ns();
 
-  /**
-   * loop untill all recombinations of this thread are done
-   */
-  for (j = evt->start; j < evt->end; j++) {
+  return NULL;
+}
 
-    /**
-     * from two randomly choosen Individuals 
-     * of the untouched (best) part we calculate an new one 
-     * */
-    rand2 = rand1 = rand128(v_rand) % ev->overall_start;
-    while (rand1 == rand2) rand2 = rand128(v_rand) % ev->overall_start; 
-    
-    /* recombinate individuals */
-    ev->recombinate(ev->population[rand1], 
-                    ev->population[rand2], 
-                    ev->population[j], 
-                    evt->opt);
-    
-    /* mutate Individuals */
-    if (ev->use_muttation) {
-      if (ev->always_mutate)
-        ev->mutate(ev->population[j], evt->opt);
-      else {
-        if (rand128(v_rand) <= ev->i_mut_propability)
-          ev->mutate(ev->population[j], evt->opt);
-      }
-    }
+/**
+ * Thread function of the spin barrier, 
+ * runs the generation work untill it is stoped
+ */
+static void *threadable_barrier(void *arg) {
 
-    /* calculate the fittnes for the new individuals */
-    EV_CALC_FITNESS_AT(ev, j, evt->opt);
+  EvThreadArgs *evt = arg;
+  Evolution *ev     = evt->ev;
+  uint32_t epoch    = 0;
 
-    /**
-     * store if the new individual is better as the old one
-     */
-    if (ev->sort_max) {
-      if (ev->population[j]->fitness > ev->population[rand1]->fitness && 
-          ev->population[j]->fitness > ev->population[rand2]->fitness) {
+  for (;;) {
 
-        evt->improovs++;
-      }
+    /* wait for the next generation */
+    epoch = ev_spin_wait(&ev->bar_epoch, 
+                         epoch, 
+                         &ev->bar_sleepers, 
+                         &evt->spin);
 
-    } else {
-      if (ev->population[j]->fitness < ev->population[rand1]->fitness && 
-          ev->population[j]->fitness < ev->population[rand2]->fitness) {
+    if (__atomic_load_n(&ev->bar_stop, __ATOMIC_ACQUIRE))
+      break;
 
-        evt->improovs++;
-      }
-    }
+    threadable_timed(arg);
 
-    /**
-     * print status informations if wanted
-     */
-    if (ev->verbose >= EV_VERBOSE_ONELINE) {
-      EV_IV_STATUS_OUTPUT(*ev, j);
+    /* the last thread wakes the main thread if it sleeps */
+    if (__atomic_add_fetch(&ev->bar_done, 1, __ATOMIC_SEQ_CST) == 
+        (uint32_t) ev->num_threads &&
+        __atomic_load_n(&ev->bar_main_sleeps, __ATOMIC_SEQ_CST)) {
 
-      if (ev->verbose >= EV_VERBOSE_ULTRA)
-        EV_THREAD_SAVE_NEW_LINE;
+      syscall(SYS_futex, &ev->bar_done, FUTEX_WAKE_PRIVATE, 1, 
+              NULL, NULL, 0);
     }
   }
 
@@ -1296,176 +5532,213 @@ static void *threadable_recombinate(void *arg) {
 }
 
 /**
- * Thread function to do mutation onely
- * if number of survivors == number of deaths
+ * Thread function of the shared pool, runs the 
+ * tasks of the Evolutions untill the pool is freed
  */
-static void *threadable_mutation_onely_1half(void *arg) {
+static void *threadable_pool(void *arg) {
 
-  EvThreadArgs *evt = arg;
-  Evolution *ev     = evt->ev;
-  int j;
-  
-  /* reset threadwide iprooves */
-  evt->improovs = 0;  
- 
-  /**
-   * loop untill all mutations of this thread are done
-   */
-  for (j = evt->start; j < evt->end; j++) {
- 
-    /**
-     * clone the current individual (from the survivors)
-     * and override an individual in the deaths-part
-     */
-    ev->clone_iv(ev->population[j]->iv, 
-                 ev->population[j - ev->overall_start]->iv, 
-                 evt->opt);
- 
-    /* muttate the cloned individual */
-    ev->mutate(ev->population[j], 
-               evt->opt);
- 
-    /* calculate the fittnes for the new individual */
-    EV_CALC_FITNESS_AT(ev, j, evt->opt);
-    
-    /**
-     * store if the new individual is better as the old one
-     */
-    if (ev->sort_max) {
-      if (EV_FITNESS_AT(ev, j) > 
-          EV_FITNESS_AT(ev, j - ev->overall_start)) {
- 
-        evt->improovs++;
-      }
- 
-    } else {
-      if (EV_FITNESS_AT(ev, j) <
-          EV_FITNESS_AT(ev, j - ev->overall_start)) {
- 
-        evt->improovs++;
-      }
-    }
-    
-    /**
-     * print status informations if wanted
-     */
-    if (ev->verbose >= EV_VERBOSE_ONELINE) {
-      EV_IV_STATUS_OUTPUT(*ev, j);
- 
-      if (ev->verbose >= EV_VERBOSE_ULTRA)
-        EV_THREAD_SAVE_NEW_LINE;
+  EvPool *pool = arg;
+  Evolution *ev;
+  int task;
+
+  pthread_mutex_lock(&pool->lock);
+
+  for (;;) {
+    ev = ev_pool_next_task(pool, &task);
+
+    if (ev == NULL) {
+      if (pool->stop)
+        break;
+
+      pthread_cond_wait(&pool->work, &pool->lock);
+      continue;
     }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    threadable_timed((void *) ev->thread_args[task]);
+
+    pthread_mutex_lock(&pool->lock);
+
+    /* the waiting thread of the Evolution */
+    if (--ev->pool_remaining == 0)
+      pthread_cond_signal(&ev->pool_done);
   }
 
+  pthread_mutex_unlock(&pool->lock);
+
   return NULL;
 }
 
 /**
- * Thread function to do mutation onely
- * if numbers of survivors != number of deaths
+ * Thread function to do steady state evolution
  */
-static void *threadable_mutation_onely_rand(void *arg) {
+static void *threadable_steady_state(void *arg) {
 
   EvThreadArgs *evt = arg;
-  Evolution *ev = evt->ev;
-  int j, rand1;
-  rand128_t *v_rand = evt->ev->rands[evt->index];
 
-  /* reset threadwide iprooves */
-  evt->improovs = 0;  
- 
-  /**
-   * loop untill all mutations are done
-   */
-  for (j = evt->start; j < evt->end; j++) {
- 
-    /**
-     * clone random individual (from the survivors)
-     * and override the current individual in the deaths-part
-     */
-    rand1 = rand128(v_rand) % ev->overall_start;
-    ev->clone_iv(ev->population[j]->iv, 
-                 ev->population[rand1]->iv, 
-                 evt->opt);
- 
-    /* muttate the cloned individual */
-    ev->mutate(ev->population[j], evt->opt);
- 
-    /* calculate the fittnes for the new individual */
-    EV_CALC_FITNESS_AT(ev, j, evt->opt);
-   
-    /**
-     * store if the new individual is better as the old one
-     */
-    if (ev->sort_max) {
-      if (ev->population[j]->fitness > ev->population[rand1]->fitness) {
- 
-        evt->improovs++;
-      }
- 
-    } else {
-      if (ev->population[j]->fitness < ev->population[rand1]->fitness) {
- 
-        evt->improovs++;
-      }
-    }
-   
-    /**
-     * print status informations if wanted
-     */
-    if (ev->verbose >= EV_VERBOSE_ONELINE) {
-      EV_IV_STATUS_OUTPUT(*ev, j);
- 
-      if (ev->verbose >= EV_VERBOSE_ULTRA)
-        EV_THREAD_SAVE_NEW_LINE;
-    }
-  }
+  ev_steady_state(evt->ev, evt->index, evt->opt);
 
   return NULL;
 }
 
 /**
- * Thread function to do greedy 
+ * Steady state evolution for the thread with the given index:
+ * repeatedly produces one offspring from random parents and replaces
+ * a random worse individual with it, untill the offsprings of all
+ * generations are born or continue_ev returned 0
+ *
+ * Note: an individual of the population is only accessed while 
+ *       holding its lock, so after replacing it, the old one can
+ *       be reused as the next private offspring
  */
-static void *threadable_greedy(void *arg) {
+static void ev_steady_state(Evolution *ev, int index, void *opt) {
 
-  EvThreadArgs *evt = arg;
-  Evolution *ev = evt->ev;
-  int j, start = evt->start;
+  rand128_t *v_rand = ev->rands[index];
+  Individual *child;
+  int64_t fitness1, fitness2, born;
+  int rand1, rand2, low, high, victim, replaced;
+  int generation_size = (ev->deaths > 0) ? ev->deaths : 1;
+  int64_t limit = (int64_t) ev->generation_limit * generation_size;
 
-  /* reset threadwide iprooves */
-  evt->improovs = 0;  
- 
-  /* initialize generation best to greedy best */
-  ev->clone_iv(ev->population[start + 1]->iv, ev->population[start]->iv, evt->opt);
-  ev->population[start + 1]->fitness = ev->population[start]->fitness;
+  while (!__atomic_load_n(&ev->steady_stop, __ATOMIC_RELAXED)) {
 
-  for (j = 0; j < ev->greedy_size; j++) {
+    born = __atomic_fetch_add(&ev->steady_born, 1, __ATOMIC_RELAXED);
+    if (born >= limit)
+      break;
 
-    /* copy greedy best and mutate it */
-    ev->clone_iv(ev->population[start + 2]->iv, ev->population[start]->iv, evt->opt);
-    ev->mutate(ev->population[start + 2], evt->opt);
+    child = ev->scratch[index];
 
-    /* calculate fitness and set generation best if neccesary */
-    EV_CALC_FITNESS_AT(ev, start + 2, evt->opt);
-    
-    EV_COPY_GREEDY_COUNT(ev, start + 1, start + 2, evt->opt, evt->improovs);
+    if (ev->use_recombination) {
+
+      /**
+       * from two randomly choosen Individuals we calculate an new one
+       * (locking them in index order to avoid deadlocks)
+       */
+      rand2 = rand1 = rand128(v_rand) % ev->population_size;
+      while (rand1 == rand2) rand2 = rand128(v_rand) % ev->population_size;
+
+      low  = (rand1 < rand2) ? rand1 : rand2;
+      high = (rand1 < rand2) ? rand2 : rand1;
+
+      pthread_mutex_lock(&ev->iv_locks[low]);
+      pthread_mutex_lock(&ev->iv_locks[high]);
+
+      ev->recombinate(ev->population[rand1], 
+                      ev->population[rand2], 
+                      child, 
+                      opt);
+
+      fitness1 = EV_FITNESS_AT(ev, rand1);
+      fitness2 = EV_FITNESS_AT(ev, rand2);
+
+      pthread_mutex_unlock(&ev->iv_locks[high]);
+      pthread_mutex_unlock(&ev->iv_locks[low]);
+
+      /* mutate Individuals */
+      if (ev->use_muttation) {
+        if (ev->always_mutate)
+          ev->mutate(child, opt);
+        else {
+          if (rand128(v_rand) <= ev->i_mut_propability)
+            ev->mutate(child, opt);
+        }
+      }
+
+    } else {
+
+      /* clone random individual and mutate it */
+      rand1 = rand128(v_rand) % ev->population_size;
+
+      pthread_mutex_lock(&ev->iv_locks[rand1]);
+
+      EV_CLONE_IV(ev, child->iv, ev->population[rand1]->iv, opt);
+      fitness1 = fitness2 = EV_FITNESS_AT(ev, rand1);
+
+      pthread_mutex_unlock(&ev->iv_locks[rand1]);
+
+      ev->mutate(child, opt);
+    }
+
+    /* calculate the fittnes for the new individual */
+    child->fitness = ev->fitness(child, opt);
+
+    /* store if the new individual is better as its parents */
+    if (EV_BETTER(ev, child->fitness, fitness1) &&
+        EV_BETTER(ev, child->fitness, fitness2)) {
+
+      __atomic_fetch_add(&ev->steady_improovs, 1, __ATOMIC_RELAXED);
+    }
 
     /**
-     * print status informations if wanted
+     * replace a random individual if it is worse than the offspring,
+     * the old one will be our next private offspring
      */
-    if (ev->verbose >= EV_VERBOSE_ONELINE) {
-      EV_IV_GREEDY_STATUS_OUTPUT(*ev, j);
+    victim   = 1 + rand128(v_rand) % (ev->population_size - 1);
+    replaced = 0;
+
+    pthread_mutex_lock(&ev->iv_locks[victim]);
+    if (EV_BETTER(ev, child->fitness, EV_FITNESS_AT(ev, victim))) {
+      ev->scratch[index]     = ev->population[victim];
+      ev->population[victim] = child;
+      replaced = 1;
+    }
+    pthread_mutex_unlock(&ev->iv_locks[victim]);
 
-      if (ev->verbose >= EV_VERBOSE_ULTRA)
-        EV_THREAD_SAVE_NEW_LINE;
+    /* keep the best individual at index zero */
+    if (replaced) {
+      pthread_mutex_lock(&ev->iv_locks[0]);
+      pthread_mutex_lock(&ev->iv_locks[victim]);
+
+      if (EV_BETTER(ev, EV_FITNESS_AT(ev, victim), EV_FITNESS_AT(ev, 0))) {
+        child                  = ev->population[0];
+        ev->population[0]      = ev->population[victim];
+        ev->population[victim] = child;
+      }
+
+      pthread_mutex_unlock(&ev->iv_locks[victim]);
+      pthread_mutex_unlock(&ev->iv_locks[0]);
     }
+
+    /* one generation worth of offsprings is born */
+    if ((born + 1) % generation_size == 0)
+      ev_steady_state_generation(ev, (born + 1) / generation_size, opt);
   }
+}
 
-  /* set greedy best if generation best is better */
-  EV_COPY_GREEDY(ev, start, start + 1, evt->opt);
+/**
+ * Called each time one generation worth of offsprings are
+ * produced in steady state mode, updates the EvolutionInfo
+ * and calls continue_ev
+ *
+ * Note: the best individual is locked during continue_ev,
+ *       the other threads keep working
+ */
+static void ev_steady_state_generation(Evolution *ev, 
+                                       int generation, 
+                                       void *opt) {
+  
+  pthread_mutex_lock(&ev->mutex);
+  pthread_mutex_lock(&ev->iv_locks[0]);
 
-  return NULL;
+  /* update progressed generations */
+  if (generation > ev->info.generations_progressed)
+    ev->info.generations_progressed = generation;
+
+  ev->info.improovs = __atomic_exchange_n(&ev->steady_improovs, 0, 
+                                          __ATOMIC_RELAXED);
+
+  if (!ev_continue(ev, opt))
+    __atomic_store_n(&ev->steady_stop, 1, __ATOMIC_RELAXED);
+
+  /**
+   * print status informations if wanted
+   */
+  if (ev->verbose >= EV_VERBOSE_HIGH)
+    EV_EVOLUTE_OUTPUT(*ev);
+
+  pthread_mutex_unlock(&ev->iv_locks[0]);
+  pthread_mutex_unlock(&ev->mutex);
 }
 
 /**
@@ -1510,17 +5783,35 @@ static void ev_init_tc_and_ivs_serial(Evolution *ev) {
   ev->overall_start = 0;
   ev->overall_end   = ev->population_size * mul;
 
+  /**
+   * in lazy mode only the parents of the first generation are 
+   * initialized now, the others are created on first use
+   */
+  int init_end = ev->overall_end;
+  if (ev->lazy_init) {
+    init_end = ev->keep_last_generation ? ev->survivors : 
+                                          ev->population_size;
+    ev_init_lazy_ivs(ev, init_end);
+  }
+
+  /* one slab for the whole population */
+  if (ev->use_arena) {
+    ev->arena_slabs = 1;
+    ev->arena_ivs   = init_end;
+    ev->arena       = (char **) calloc(1, sizeof(char *));
+    ev_arena_slab(ev, 0);
+  }
 
   /**
    * Loop untill all individuals of this thread are initialized
    */
-  for (i = 0; i < ev->overall_end; i++) {
+  for (i = 0; i < init_end; i++) {
      
     /**
      * create new individual
      */
     ev->population[i]     = ev->ivs + i;
-    ev->population[i]->iv = ev->init_iv(*ev->opts);
+    ev->population[i]->iv = EV_NEW_IV(ev, i, *ev->opts);
     EV_CALC_FITNESS_AT(ev, i, *ev->opts);
 
     /**
@@ -1538,8 +5829,12 @@ static void ev_init_tc_and_ivs_serial(Evolution *ev) {
    * Select the best individual to survive,
    * Sort the Individuals by their fittnes
    */
-  if (!ev->use_greedy)
-    EV_SELECTION(ev); 
+  if (ev->lazy_init)
+    EV_SELECTION_AT(ev, 0, init_end);
+  else if (ev->partial_selection)
+    ev_partition(ev, ev->survivors);
+  else if (!ev->use_greedy)
+    EV_SORT(ev, ev->num_threads > 1); 
 
   if (ev->verbose >= EV_VERBOSE_HIGH)
     printf("Population Initialized\n");
@@ -1574,8 +5869,7 @@ static void ev_init_tc_and_ivs_greedy_serial(Evolution *ev) {
     /**
      * create new individual
      */
-    ev->free_iv(ev->population[1]->iv, *ev->opts);
-    ev->population[1]->iv = ev->init_iv(*ev->opts);
+    EV_RENEW_IV(ev, 1, *ev->opts);
     EV_CALC_FITNESS_AT(ev, 1, *ev->opts);
 
     /* set best individual if neccesary */
@@ -1585,10 +5879,10 @@ static void ev_init_tc_and_ivs_greedy_serial(Evolution *ev) {
      * prints status informations if wanted
      */
     if (ev->verbose >= EV_VERBOSE_ONELINE) {
-      EV_INIT_IV_OUTPUT(i);
+      EV_INIT_IV_OUTPUT(*ev, i);
 
       if (ev->verbose >= EV_VERBOSE_HIGH)
-        EV_THREAD_SAVE_NEW_LINE;
+        EV_THREAD_SAVE_NEW_LINE(*ev);
     }
   }
 
@@ -1623,19 +5917,31 @@ static inline void greedy_ivs_seriel(Evolution *ev) {
   ev->info.improovs = 0;
 
   /* initialize generation best to greedy best */
-  ev->clone_iv(ev->population[1]->iv, ev->population[0]->iv, *ev->opts);
+  EV_CLONE_IV(ev, ev->population[1]->iv, ev->population[0]->iv, *ev->opts);
   ev->population[1]->fitness = ev->population[0]->fitness;
 
+  /* the working copy is only reverted after each candidate */
+  if (ev->use_undo)
+    EV_CLONE_IV(ev, ev->population[2]->iv, ev->population[0]->iv, *ev->opts);
+
   for (j = 0; j < ev->greedy_size; j++) {
 
     /* copy greedy best and mutate it */
-    ev->clone_iv(ev->population[2]->iv, ev->population[0]->iv, *ev->opts);
-    ev->mutate(ev->population[2], *ev->opts);
+    if (ev->use_undo) {
+      ev->mutate_undoable(ev->population[2], EV_UNDO_AT(ev, 0), *ev->opts);
+    } else {
+      EV_CLONE_IV(ev, ev->population[2]->iv, ev->population[0]->iv, *ev->opts);
+      ev->mutate(ev->population[2], *ev->opts);
+    }
 
     /* calculate fitness and set generation best if neccesary */
     EV_CALC_FITNESS_AT(ev, 2, *ev->opts);
     
     EV_COPY_GREEDY_COUNT(ev, 1, 2, *ev->opts, ev->info.improovs);
+
+    /* revert the working copy to the greedy best */
+    if (ev->use_undo)
+      ev->undo(ev->population[2], EV_UNDO_AT(ev, 0), *ev->opts);
   }
 
   /* set greedy best if generation best is better */
@@ -1647,7 +5953,7 @@ static inline void greedy_ivs_seriel(Evolution *ev) {
  */
 static void seriel_recombinate(Evolution *ev) {
 
-  int j, rand1, rand2;
+  int j;
 
   /**
    * for recombination there musst be min two individuals
@@ -1665,49 +5971,13 @@ static void seriel_recombinate(Evolution *ev) {
    */
   for (j = ev->overall_start; j < ev->overall_end; j++) {
 
-    /**
-     * from two randomly choosen Individuals 
-     * of the untouched (best) part we calculate an new one 
-     * */
-    rand2 = rand1 = rand128(ev->rands[0]) % ev->overall_start;
-    while (rand1 == rand2) rand2 = rand128(ev->rands[0]) % ev->overall_start; 
-    
-    /* recombinate individuals */
-    ev->recombinate(ev->population[rand1], 
-                    ev->population[rand2], 
-                    ev->population[j], 
-                    *ev->opts);
-    
-    /* mutate Individuals */
-    if (ev->use_muttation) {
-      if (ev->always_mutate)
-        ev->mutate(ev->population[j], *ev->opts);
-      else {
-        if (rand128(ev->rands[0]) <= ev->i_mut_propability)
-          ev->mutate(ev->population[j], *ev->opts);
-      }
-    }
-
-    /* calculate the fittnes for the new individuals */
-    EV_CALC_FITNESS_AT(ev, j, *ev->opts);
-
-    /**
-     * store if the new individual is better as the old one
-     */
-    if (ev->sort_max) {
-      if (ev->population[j]->fitness > ev->population[rand1]->fitness && 
-          ev->population[j]->fitness > ev->population[rand2]->fitness) {
-
-        ev->info.improovs++;
-      }
-
-    } else {
-      if (ev->population[j]->fitness < ev->population[rand1]->fitness && 
-          ev->population[j]->fitness < ev->population[rand2]->fitness) {
-
-        ev->info.improovs++;
-      }
-    }
+    ev->info.improovs += ev_recombinate_at(ev, 
+                                           j, 
+                                           0, 
+                                           ev->overall_start, 
+                                           ev->rands[0], 
+                                           *ev->opts,
+                                           NULL);
 
     /**
      * print status informations if wanted
@@ -1741,34 +6011,11 @@ static void seriel_mutation_onely_1half(Evolution *ev) {
      * clone the current individual (from the survivors)
      * and override an individual in the deaths-part
      */
-    ev->clone_iv(ev->population[j]->iv, 
-                 ev->population[j - ev->overall_start]->iv, 
-                 *ev->opts);
- 
-    /* muttate the cloned individual */
-    ev->mutate(ev->population[j], 
-               *ev->opts);
- 
-    /* calculate the fittnes for the new individual */
-    EV_CALC_FITNESS_AT(ev, j, *ev->opts);
-    
-    /**
-     * store if the new individual is better as the old one
-     */
-    if (ev->sort_max) {
-      if (EV_FITNESS_AT(ev, j) > 
-          EV_FITNESS_AT(ev, j - ev->overall_start)) {
- 
-        ev->info.improovs++;
-      }
- 
-    } else {
-      if (EV_FITNESS_AT(ev, j) <
-          EV_FITNESS_AT(ev, j - ev->overall_start)) {
- 
-        ev->info.improovs++;
-      }
-    }
+    ev->info.improovs += ev_mutate_at(ev, 
+                                      j, 
+                                      j - ev->overall_start, 
+                                      *ev->opts,
+                                      NULL);
     
     /**
      * print status informations if wanted
@@ -1788,7 +6035,7 @@ static void seriel_mutation_onely_1half(Evolution *ev) {
  */
 static void seriel_mutation_onely_rand(Evolution *ev) {
 
-  int j, rand1;
+  int j;
 
   /* reset threadwide iprooves */
   ev->info.improovs = 0;  
@@ -1802,32 +6049,14 @@ static void seriel_mutation_onely_rand(Evolution *ev) {
      * clone random individual (from the survivors)
      * and override the current individual in the deaths-part
      */
-    rand1 = rand128(ev->rands[0]) % ev->overall_start;
-    ev->clone_iv(ev->population[j]->iv, 
-                 ev->population[rand1]->iv, 
-                 *ev->opts);
- 
-    /* muttate the cloned individual */
-    ev->mutate(ev->population[j], *ev->opts);
- 
-    /* calculate the fittnes for the new individual */
-    EV_CALC_FITNESS_AT(ev, j, *ev->opts);
-   
-    /**
-     * store if the new individual is better as the old one
-     */
-    if (ev->sort_max) {
-      if (ev->population[j]->fitness > ev->population[rand1]->fitness) {
- 
-        ev->info.improovs++;
-      }
- 
-    } else {
-      if (ev->population[j]->fitness < ev->population[rand1]->fitness) {
- 
-        ev->info.improovs++;
-      }
-    }
+    ev->info.improovs += ev_mutate_at(ev, 
+                                      j, 
+                                      ev_pick_parent(ev, 
+                                                     0, 
+                                                     ev->overall_start, 
+                                                     ev->rands[0]), 
+                                      *ev->opts,
+                                      NULL);
    
     /**
      * print status informations if wanted
@@ -1857,11 +6086,16 @@ void ev_inspect(Evolution *ev) {
          "keep_last_generation:  %d\n\t"
          "use_abort_requirement: %d\n\t"
          "use_greedy:            %d\n\t"
+         "use_processes:         %d\n\t"
+         "process_index:         %d\n\t"
+         "num_processes:         %d\n\t"
          "deaths:                %d\n\t"
          "survivors:             %d\n\t"
          "sort_max:              %d\n\t"
          "verbose:               %d\n\t"
          "min_quicksort:         %d\n\t"
+         "chunks_per_thread:     %d\n\t"
+         "chunk_size:            %d\n\t"
          "num_threads:           %d\n\t"
          "overall_start:         %d\n\t"
          "overall_end:           %d\n\t"
@@ -1876,11 +6110,16 @@ void ev_inspect(Evolution *ev) {
          ev->keep_last_generation,
          ev->use_abort_requirement,
          ev->use_greedy,
+         ev->use_processes,
+         ev->process_index,
+         ev->num_processes,
          ev->deaths,
          ev->survivors,
          ev->sort_max,
          ev->verbose,
          ev->min_quicksort,
+         ev->chunks_per_thread,
+         ev->chunk_size,
          ev->num_threads,
          ev->overall_start,
          ev->overall_end,
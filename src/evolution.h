@@ -22,21 +22,6 @@
 #include "C-Utils/Thread-Clients/src/thread-client.h"
 #include "C-Utils/Rand/src/rand.h"
 
-/**
- * Macro for changing TC to pthread
- * 
- * its seams to depending on the specific
- * work the evolution gets if thread clients
- * or pthread syscalls are faster
- */
-#ifdef NO_THREAD_CLIENTS
-#define TClient pthread_t
-#define tc_add_func(THREAD, FUNCTION, ARGS)     \
-  pthread_create(THREAD, NULL, FUNCTION, ARGS)
-#define tc_join(THREAD) pthread_join(*(THREAD), NULL);
-#define init_thread_client(THREAD) (void) THREAD
-#endif
-
 /**
  * Type definition for the Evolution struct
  */
@@ -47,6 +32,37 @@ typedef struct Evolution Evolution;
  */
 #define EV_QICKSORT_MIN 20
 
+/**
+ * Number of chunks each thread slice is split into
+ * for the work-stealing scheduler (the smaller the chunks
+ * the better the load balancing, but the more locking)
+ */
+#define EV_CHUNKS_PER_THREAD 8
+
+/**
+ * Min population size to sort the population with the (parallel)
+ * radix sort instead of the quick insertion sort, and the number 
+ * of bits sorted by each pass of the radix sort
+ */
+#define EV_RADIX_MIN 65536
+#define EV_RADIX_BITS 11
+#define EV_RADIX_BUCKETS (1 << EV_RADIX_BITS)
+
+/**
+ * Alignment of the genome slabs in arena mode (one cache line)
+ * and of each genome within its slab
+ */
+#define EV_ARENA_ALIGN 64
+#define EV_GENOME_ALIGN 16
+
+/**
+ * Bounds of the adaptive spin budget of the spin barrier
+ * (number of spins before a waiting thread sleeps on a futex,
+ * doubled if spinning was succesfull and halfed if not)
+ */
+#define EV_SPIN_MIN 16
+#define EV_SPIN_MAX 65536
+
 /**
  * Flags for the EvInitArgs
  *
@@ -64,6 +80,36 @@ typedef struct Evolution Evolution;
 #define EV_VERBOSE_HIGH           512
 #define EV_VERBOSE_ULTRA          768
 #define EV_USE_GREEDY             64
+#define EV_STEADY_STATE           128
+#define EV_USE_ISLANDS            1024
+#define EV_USE_PROCESSES          2048
+#define EV_EXECUTOR_TCLIENT       0
+#define EV_EXECUTOR_POOL          8192
+#define EV_EXECUTOR_PTHREAD       16384
+#define EV_EXECUTOR_SERIAL        24576
+#define EV_EXECUTOR_SHARED        32768
+#define EV_EXECUTOR_MASK          57344
+#define EV_AFFINITY_NONE          0
+#define EV_AFFINITY_COMPACT       65536
+#define EV_AFFINITY_SCATTER       131072
+#define EV_AFFINITY_LIST          196608
+#define EV_AFFINITY_MASK          196608
+#define EV_GREEDY_ASYNC           262144
+#define EV_ASYNC_FITNESS          524288
+#define EV_LAZY_INIT              1048576
+#define EV_USE_TUNING             2097152
+#define EV_PARTIAL_SELECTION      4194304
+#define EV_MERGE_SELECTION        8388608
+#define EV_PARENT_UNIFORM         0
+#define EV_PARENT_TOURNAMENT      16777216
+#define EV_PARENT_PROPORTIONAL    33554432
+#define EV_PARENT_RANK            50331648
+#define EV_PARENT_MASK            50331648
+#define EV_ARENA                  67108864
+#define EV_POD_GENOME             134217728
+#define EV_USE_REINIT             268435456
+#define EV_DELTA_OFFSPRING        536870912
+#define EV_UNDO_MUTATION          1073741824
 
 /**
  * Shorter Flags
@@ -80,6 +126,92 @@ typedef struct Evolution Evolution;
 #define EV_VEB2 EV_VERBOSE_HIGH
 #define EV_VEB3 EV_VERBOSE_ULTRA
 #define EV_GRDY EV_USE_GREEDY
+#define EV_STST EV_STEADY_STATE
+#define EV_ISLE EV_USE_ISLANDS
+#define EV_PROC EV_USE_PROCESSES
+#define EV_ETCL EV_EXECUTOR_TCLIENT
+#define EV_EPOL EV_EXECUTOR_POOL
+#define EV_EPTH EV_EXECUTOR_PTHREAD
+#define EV_ESER EV_EXECUTOR_SERIAL
+#define EV_ESHR EV_EXECUTOR_SHARED
+#define EV_ANON EV_AFFINITY_NONE
+#define EV_ACMP EV_AFFINITY_COMPACT
+#define EV_ASCT EV_AFFINITY_SCATTER
+#define EV_ALST EV_AFFINITY_LIST
+#define EV_GASY EV_GREEDY_ASYNC
+#define EV_AFIT EV_ASYNC_FITNESS
+#define EV_LAZY EV_LAZY_INIT
+#define EV_TUNE EV_USE_TUNING
+#define EV_PSEL EV_PARTIAL_SELECTION
+#define EV_MSEL EV_MERGE_SELECTION
+#define EV_PUNI EV_PARENT_UNIFORM
+#define EV_PTRN EV_PARENT_TOURNAMENT
+#define EV_PPRP EV_PARENT_PROPORTIONAL
+#define EV_PRNK EV_PARENT_RANK
+#define EV_ARNA EV_ARENA
+#define EV_PODG EV_POD_GENOME
+#define EV_RINI EV_USE_REINIT
+#define EV_DLTA EV_DELTA_OFFSPRING
+#define EV_UNDO EV_UNDO_MUTATION
+
+/**
+ * Migration topologies for the island model
+ *
+ * EV_MIGRATE_RING:   island i sends its elites to island i + 1
+ * EV_MIGRATE_RANDOM: each island receives the elites of an other
+ *                    randomly choosen island
+ * EV_MIGRATE_FULL:   each island receives the elites of all other
+ *                    islands (round robin over the islands, best first)
+ */
+#define EV_MIGRATE_RING           0
+#define EV_MIGRATE_RANDOM         1
+#define EV_MIGRATE_FULL           2
+
+/**
+ * Number of migrants each process can hold in its shared memory
+ * ring buffer (in process mode), migrants are droped if it is full
+ */
+#define EV_SHM_RING_SLOTS 64
+
+/**
+ * Thread pool wich can be shared by many Evolutions
+ * (see EV_EXECUTOR_SHARED)
+ *
+ * +------------------------------------+-------------------------------------+
+ * | Value                              | describtion                         |
+ * +------------------------------------+-------------------------------------+
+ * | pthread_mutex_t lock               | guards the pool and the task        |
+ * |                                    | counters of its Evolutions          |
+ * |                                    |                                     |
+ * | pthread_cond_t work                | signaled if there are new tasks     |
+ * |                                    |                                     |
+ * | pthread_t *threads                 | the threads of the pool             |
+ * |                                    |                                     |
+ * | int num_threads                    | number of threads of the pool       |
+ * |                                    |                                     |
+ * | Evolution **clients                | the Evolutions using this pool      |
+ * |                                    |                                     |
+ * | int num_clients                    | number of Evolutions using the pool |
+ * |                                    |                                     |
+ * | int max_clients                    | size of clients                     |
+ * |                                    |                                     |
+ * | int next_client                    | the Evolution wich gets the next    |
+ * |                                    | free thread (round robin)           |
+ * |                                    |                                     |
+ * | char stop                          | set to stop the threads             |
+ * +------------------------------------+-------------------------------------+
+ */
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t  work;
+  pthread_t       *threads;
+  int             num_threads;
+  Evolution       **clients;
+  int             num_clients;
+  int             max_clients;
+  int             next_client;
+  char            stop;
+} EvPool;
 
 /**
  * Structur holding aditional information during an evolution
@@ -93,11 +225,17 @@ typedef struct Evolution Evolution;
  * |                                    |                                     |
  * | int generations_progressed         | indicates how many generations are  |
  * |                                    | are already processed               |
+ * |                                    |                                     |
+ * | uint64_t barrier_wait_ns           | nanoseconds all threads together    |
+ * |                                    | spend waiting to be started and for |
+ * |                                    | the other threads to finish during  |
+ * |                                    | the last generation                 |
  * +------------------------------------+-------------------------------------+
  */
 typedef struct {
  int improovs; 
  int generations_progressed;
+ uint64_t barrier_wait_ns;
 } EvolutionInfo;
 
 /**
@@ -109,6 +247,64 @@ typedef struct {
   int64_t fitness;             /* the fitness of this Individual */
 } Individual;
 
+/**
+ * One element of the fitness key store (used by the selection and
+ * the radix sort): the fitness as an unsigned key (in sort order)
+ * and the Individual it belongs to
+ */
+typedef struct {
+  uint64_t   key;
+  Individual *iv;
+} EvKey;
+
+/**
+ * Handle of an Evolution running in the background (see evolute_async)
+ *
+ * +------------------------------------+-------------------------------------+
+ * | Value                              | describtion                         |
+ * +------------------------------------+-------------------------------------+
+ * | Evolution *ev                      | the running Evolution               |
+ * |                                    |                                     |
+ * | pthread_t thread                   | the thread running evolute          |
+ * |                                    |                                     |
+ * | pthread_mutex_t lock               | guards the snapshot request         |
+ * |                                    |                                     |
+ * | pthread_cond_t served              | signaled if a snapshot is taken     |
+ * |                                    |                                     |
+ * | Individual *snapshot               | the Individual to clone the best    |
+ * |                                    | into at the next generation (or     |
+ * |                                    | NULL if there is no request)        |
+ * |                                    |                                     |
+ * | int epoch                          | the generation the last snapshot    |
+ * |                                    | was taken at                        |
+ * |                                    |                                     |
+ * | Individual *best                   | the result of evolute               |
+ * |                                    |                                     |
+ * | int64_t best_fitness               | fitness of the best Individual and  |
+ * | int generations                    | number of generations at the last   |
+ * |                                    | generation change (can be read at   |
+ * |                                    | any time)                           |
+ * |                                    |                                     |
+ * | char finished                      | set if evolute has returned         |
+ * |                                    |                                     |
+ * | char cancelled                     | set to stop the evolution at the    |
+ * |                                    | next generation                     |
+ * +------------------------------------+-------------------------------------+
+ */
+typedef struct {
+  Evolution       *ev;
+  pthread_t       thread;
+  pthread_mutex_t lock;
+  pthread_cond_t  served;
+  Individual      *snapshot;
+  int             epoch;
+  Individual      *best;
+  int64_t         best_fitness;
+  int             generations;
+  char            finished;
+  char            cancelled;
+} EvAsync;
+
 /**
  * Struct containg the neccesary information
  * to initalize an Evolution struct
@@ -183,7 +379,123 @@ typedef struct {
  * |                                    |                                     |
  * | int num_threads                    | number of threads to use            |
  * |                                    |                                     |
- * | uint16_t flags                     | flags are discussed below           |
+ * | int migration_interval             | island model: number of generations |
+ * |                                    | between two migrations              |
+ * |                                    |                                     |
+ * | int migration_size                 | island model: number of elites      |
+ * |                                    | migrating into the place of the     |
+ * |                                    | worst individuals of an island      |
+ * |                                    |                                     |
+ * | int migration_topology             | island model: one of the            |
+ * |                                    | EV_MIGRATE_* topologies             |
+ * |                                    |                                     |
+ * | size_t serialize_iv(void *dst,     | process mode: takes an buffer of    |
+ * |                     size_t size,   | size (migrant_size) bytes (see      |
+ * |                     void *src,     | ev_launch_processes) and an void    |
+ * |                     void *opts)    | pointer to an individual, should    |
+ * |                                    | write the individual into the       |
+ * |                                    | buffer and return the bytes written |
+ * |                                    | (at most size, or 0 if it doesn't   |
+ * |                                    | fit, then it isn't migrated)        |
+ * |                                    |                                     |
+ * | void deserialize_iv(void *dst,     | process mode: the reverse of        |
+ * |                     const void     | serialize_iv, should restore the    |
+ * |                     *src,          | individual from the size bytes in   |
+ * |                     size_t size,   | the buffer into the (already        |
+ * |                     void *opts)    | initialized) individual dst         |
+ * |                                    |                                     |
+ * | const char *shm_name               | process mode: name of the shared    |
+ * |                                    | memory given to ev_launch_processes |
+ * |                                    |                                     |
+ * | int process_index                  | process mode: index of the current  |
+ * |                                    | process (given to the run function  |
+ * |                                    | of ev_launch_processes)             |
+ * |                                    |                                     |
+ * | EvPool *pool                       | the pool to use (only used with     |
+ * |                                    | EV_EXECUTOR_SHARED)                 |
+ * |                                    |                                     |
+ * | const int *cpus                    | the cpus for the threads (only used |
+ * |                                    | with EV_AFFINITY_LIST), thread i is |
+ * | int num_cpus                       | pinned to cpus[i % num_cpus]        |
+ * |                                    |                                     |
+ * | void submit_fitness(               | async fitness: should start to      |
+ * |        Individual *iv,             | calculate the fitness of iv without |
+ * |        void *opts)                 | waiting for the result              |
+ * |                                    |                                     |
+ * | Individual *complete_fitness(      | async fitness: should return an     |
+ * |        char wait,                  | Individual submitted with the same  |
+ * |        void *opts)                 | opts with its fitness set, if none  |
+ * |                                    | is finished it should wait for one  |
+ * |                                    | or return NULL if wait is 0 (it     |
+ * |                                    | must not return NULL if wait is set |
+ * |                                    | or an individual which wasn't       |
+ * |                                    | submitted, the evolution aborts     |
+ * |                                    | then)                               |
+ * |                                    |                                     |
+ * | int max_in_flight                  | async fitness: max number of        |
+ * |                                    | submitted individuals per thread    |
+ * |                                    |                                     |
+ * | int tournament_size                | number of individuals of one        |
+ * |                                    | tournament, at most the number of   |
+ * |                                    | parents (only used with             |
+ * |                                    | EV_PARENT_TOURNAMENT)               |
+ * |                                    |                                     |
+ * | int min_quicksort                  | min array length to change from     |
+ * |                                    | quick to insertion sort (only used  |
+ * |                                    | with EV_USE_TUNING)                 |
+ * |                                    |                                     |
+ * | int chunks_per_thread              | number of chunks each thread slice  |
+ * |                                    | is split into (only used with       |
+ * |                                    | EV_USE_TUNING)                      |
+ * |                                    |                                     |
+ * | int min_radix                      | min population size to use the      |
+ * |                                    | radix sort (only used with          |
+ * |                                    | EV_USE_TUNING)                      |
+ * |                                    |                                     |
+ * | void init_iv_at(void *genome,      | arena mode: should initialize an    |
+ * |                 void *opts)        | individual in the given buffer of   |
+ * |                                    | genome_size bytes (see EV_ARENA)    |
+ * |                                    |                                     |
+ * | size_t genome_size                 | arena or pod mode: bytes of one     |
+ * |                                    | genome                              |
+ * |                                    |                                     |
+ * | void reinit_iv(void *iv,           | should override the given           |
+ * |                void *opts)         | individual with a new random one    |
+ * |                                    | (only used with EV_USE_REINIT)      |
+ * |                                    |                                     |
+ * | void *alloc_iv(void *opts)         | lazy mode: should return an         |
+ * |                                    | uninitialized individual wich is    |
+ * |                                    | overridden before it is used (see   |
+ * |                                    | EV_LAZY_INIT)                       |
+ * |                                    |                                     |
+ * | void mutate_delta(                 | delta mode: should write a patch of |
+ * |        Individual *parent,         | a mutation of the parent into the   |
+ * |        void *delta,                | delta buffer (without changing the  |
+ * |        void *opts)                 | parent)                             |
+ * |                                    |                                     |
+ * | int64_t fitness_delta(             | delta mode: should return the       |
+ * |        Individual *parent,         | fitness of the parent with the      |
+ * |        void *delta,                | given patch applied                 |
+ * |        void *opts)                 |                                     |
+ * |                                    |                                     |
+ * | void apply_delta(void *iv,         | delta mode: should apply the given  |
+ * |                  void *delta,      | patch to the individual (wich is a  |
+ * |                  void *opts)       | clone of the parent)                |
+ * |                                    |                                     |
+ * | size_t delta_size                  | delta mode: bytes of one patch      |
+ * |                                    |                                     |
+ * | void mutate_undoable(              | undo mode: should mutate the        |
+ * |        Individual *iv,             | individual in place and log what is |
+ * |        void *undo,                 | needed to revert it into the undo   |
+ * |        void *opts)                 | buffer                              |
+ * |                                    |                                     |
+ * | void undo(Individual *iv,          | undo mode: should revert the last   |
+ * |           void *undo,              | mutation of the individual with the |
+ * |           void *opts)              | given undo buffer                   |
+ * |                                    |                                     |
+ * | size_t undo_size                   | undo mode: bytes of one undo buffer |
+ * |                                    |                                     |
+ * | uint32_t flags                     | flags are discussed below           |
  * +------------------------------------+-------------------------------------+
  *
  * Note: - The void pointer to ivs are not pointer to an Individual 
@@ -204,10 +516,258 @@ typedef struct {
  *    EV_VER1 / EV_VERBOSE_ONELINE
  *    EV_VER2 / EV_VERBOSE_HIGH
  *    EV_VER3 / EV_VERBOSE_ULTRA
+ *    EV_GRDY / EV_USE_GREEDY
+ *    EV_STST / EV_STEADY_STATE
+ *    EV_ISLE / EV_USE_ISLANDS
+ *    EV_PROC / EV_USE_PROCESSES
+ *    EV_ETCL / EV_EXECUTOR_TCLIENT
+ *    EV_EPOL / EV_EXECUTOR_POOL
+ *    EV_EPTH / EV_EXECUTOR_PTHREAD
+ *    EV_ESER / EV_EXECUTOR_SERIAL
+ *    EV_ESHR / EV_EXECUTOR_SHARED
+ *    EV_ANON / EV_AFFINITY_NONE
+ *    EV_ACMP / EV_AFFINITY_COMPACT
+ *    EV_ASCT / EV_AFFINITY_SCATTER
+ *    EV_ALST / EV_AFFINITY_LIST
+ *    EV_GASY / EV_GREEDY_ASYNC
+ *    EV_AFIT / EV_ASYNC_FITNESS
+ *    EV_LAZY / EV_LAZY_INIT
+ *    EV_TUNE / EV_USE_TUNING
+ *    EV_PSEL / EV_PARTIAL_SELECTION
+ *    EV_MSEL / EV_MERGE_SELECTION
+ *    EV_PUNI / EV_PARENT_UNIFORM
+ *    EV_PTRN / EV_PARENT_TOURNAMENT
+ *    EV_PPRP / EV_PARENT_PROPORTIONAL
+ *    EV_PRNK / EV_PARENT_RANK
+ *    EV_ARNA / EV_ARENA
+ *    EV_PODG / EV_POD_GENOME
+ *    EV_RINI / EV_USE_REINIT
+ *    EV_DLTA / EV_DELTA_OFFSPRING
+ *    EV_UNDO / EV_UNDO_MUTATION
  *
  * To all of the combinations below an EV_SMIN / EV_SMAX can be added
  * standart is EV_SMIN
  *
+ * To all of the combinations below containing EV_KEEP an EV_STST can be
+ * added, which runs the evolution in steady state mode: instead of
+ * generation changes each thread repeatedly picks random parents, produces
+ * one offspring, calculates its fitness and replaces a random worse
+ * individual in place. There is no global sort and no synchronization
+ * between the threads, population[0] is allways the best individual.
+ * One generation is counted each time deaths offsprings are produced,
+ * and continue_ev is called from the thread which completed the
+ * generation (while the other threads keep working)
+ *
+ * To all of the combinations below containing EV_KEEP an EV_ISLE can be
+ * added (but not together with EV_STST) to use the island model: each
+ * thread gets its own sub-population (island) which it sorts and evolves
+ * on its own. Only every migration_interval generations the threads
+ * are synchronized and the migration_size best individuals of each
+ * island replace the worst individuals of the islands next to it 
+ * (depending on migration_topology). Afterwards the best individual of
+ * all islands is moved to population[0] and continue_ev is called.
+ * The migration_* values are only used together with EV_ISLE and
+ * at least two threads are needed.
+ *
+ * To all of the combinations below containing EV_KEEP an EV_PROC can be
+ * added (but not together with EV_STST or EV_ISLE) to run one Evolution
+ * per process as one island of a bigger population: the processes are
+ * started by ev_launch_processes, each pinned to its own set of cpus
+ * (and so to its own memory and malloc arena). Every migration_interval
+ * generations the migration_size best individuals are serialized into
+ * a lock free ring buffer in shared memory, which is read by the next
+ * process (ring topology). The received migrants replace the worst new
+ * individuals right before the selection. The serialize_iv, 
+ * deserialize_iv, shm_name and process_index values are only used 
+ * together with EV_PROC.
+ *
+ * To all of the combinations below (except EV_GRDY and not together with
+ * EV_STST) an EV_AFIT can be added to calculate the fitness of the new 
+ * individuals asynchronous (usefull if the fitness function waits for 
+ * an external process): instead of calling fitness the threads submit 
+ * each new individual with submit_fitness and go on breeding the next 
+ * one, untill max_in_flight individuals are submitted. Then they wait
+ * with complete_fitness for one of them. Before the selection all
+ * submitted individuals are completed. The fitness function is still
+ * used for the initial population and if there is only one thread.
+ *
+ * To all of the combinations below (except EV_GRDY and not together with
+ * EV_STST or EV_ISLE) an EV_LAZY can be added to start evolving
+ * before the whole population is initialized: only the parents of the 
+ * first generation (the survivors, or the whole population without 
+ * EV_KEEP) are created with init_iv, calculated and sorted before the
+ * first generation starts. The other individuals are never initialized
+ * randomly: the thread which breeds into them for the first time only 
+ * allocates them with alloc_iv (or with malloc of genome_size bytes for
+ * pod genomes without alloc_iv), because the breeding overrides them
+ * anyway. This saves the init_iv calls (and fitness calculations) of all
+ * deaths, but with EV_KEEP the first parents are choosen from less 
+ * individuals.
+ *
+ * To all of the combinations below (except EV_GRDY and not together with
+ * EV_STST, EV_ISLE or EV_PROC) an EV_PSEL can be added to 
+ * replace the sort after each generation with a partial selection: the
+ * survivors are only partitioned to the front of the population (best 
+ * individual first) in O(n) (introselect), because breeding doesn't 
+ * need them sorted. So continue_ev only sees the best individual at
+ * population[0] and the survivors unsorted behind it (call ev_rank if 
+ * the ranks are needed). The final population is sorted as usual.
+ *
+ * To all of the combinations below containing EV_KEEP (except EV_GRDY 
+ * and not together with EV_STST, EV_ISLE or EV_PSEL) an EV_MSEL
+ * can be added to sort the population by merging: the survivors are 
+ * still sorted from the last generation, so after a generation each
+ * thread only sorts the new individuals of its own slice and the sorted
+ * slices are merged with the survivors in O(n log(num_threads)).
+ *
+ * To all of the combinations below (except EV_GRDY and not together with
+ * EV_STST, EV_ISLE, EV_PROC, EV_PSEL or EV_MSEL) one parent 
+ * selection can be added, wich chooses the parents (out of the 
+ * survivors, or out of the whole population without EV_KEEP):
+ *
+ *    EV_PARENT_UNIFORM      (EV_PUNI) each parent has the same chance
+ *                                     (standart)
+ *    EV_PARENT_TOURNAMENT   (EV_PTRN) the best of tournament_size random
+ *                                     individuals
+ *    EV_PARENT_PROPORTIONAL (EV_PPRP) the chance is proportional to the
+ *                                     distance to the worst parent (plus
+ *                                     one), sampled from an alias table
+ *                                     wich is build before each generation
+ *    EV_PARENT_RANK         (EV_PRNK) the chance is proportional to the 
+ *                                     number of worse parents (plus one),
+ *                                     sampled from an alias table wich 
+ *                                     only depends on the number of parents
+ *
+ * The tournament and the proportional selection don't need a sorted
+ * population, so the sort after each generation is replaced by a
+ * partition of the survivors (best individual first, see EV_PSEL).
+ * The rank selection needs the ranks, so the population is sorted 
+ * as usual. The tournament_size is only used with EV_PTRN.
+ *
+ * To all of the combinations below an EV_TUNE can be added to use the
+ * min_quicksort, chunks_per_thread and min_radix values of the args 
+ * instead of EV_QICKSORT_MIN, EV_CHUNKS_PER_THREAD and EV_RADIX_MIN 
+ * (ev_autotune sets them).
+ *
+ * To all of the combinations below (except EV_GRDY and not together with
+ * EV_STST or EV_LAZY) an EV_ARENA can be added to let the Evolution 
+ * allocate the genomes: each thread slice gets one slab of genome_size
+ * bytes per individual (EV_ARENA_ALIGN aligned, each genome 
+ * EV_GENOME_ALIGN aligned), wich is touched first by the thread 
+ * initializing it. The individuals are created with init_iv_at inside
+ * the slabs instead of init_iv, and the slabs are freed at once by 
+ * evolution_clean_up without calling free_iv. So a genome must not own
+ * other allocations (pointers into its own buffer are fine). At the end
+ * of each evolute the best individual is copied out of the arena into
+ * a new malloced genome (with init_iv_at and clone_iv), wich is 
+ * returned instead of population[0]. It belongs to the caller and is
+ * the only one free_iv is called for (by you, or by ev_portfolio and 
+ * ev_autotune), so each call of evolute returns an new one.
+ *
+ * To all of the combinations below an EV_PODG can be added if the genomes
+ * are flat blobs of genome_size bytes without any pointers: the Evolution
+ * clones them with memcpy and frees them with free (or with their slabs 
+ * in arena mode) instead of calling clone_iv and free_iv, wich may be 
+ * NULL then. So the best individual has to be freed with free too.
+ *
+ * To all of the combinations below an EV_RINI can be added to reuse the
+ * storage of individuals wich are replaced by new random ones (the 
+ * greedy_individuals candidates of EV_GRDY): reinit_iv overrides them 
+ * in place instead of calling free_iv and init_iv for each of them.
+ *
+ * To all of the combinations below containing EV_KEEP and not EV_UREC
+ * (except EV_GRDY and not together with EV_STST, EV_ISLE, EV_PROC, 
+ * EV_AFIT or EV_LAZY) an EV_DLTA can be added to store the 
+ * offsprings as patches of their parents (usefull for big genomes and
+ * small mutations): instead of cloning and mutating the parent, 
+ * mutate_delta writes the patch of one mutation into a buffer of 
+ * delta_size bytes, and fitness_delta calculates the fitness of the 
+ * patched parent. Only the offsprings wich survive the selection are
+ * materialized by all threads together (the parent is cloned into them
+ * and apply_delta applies the patch), so the others never touch their
+ * genome. At the end of
+ * evolute all individuals are materialized.
+ *
+ * To EV_GRDY (with or without EV_GASY) an EV_UNDO can be added to 
+ * mutate the candidates in place: instead of cloning the greedy best for
+ * each candidate, it is cloned once per generation into a working copy,
+ * mutate_undoable mutates that copy and logs the mutation into an undo 
+ * buffer of undo_size bytes, and after the fitness is calculated undo
+ * reverts it. So only the improovements are cloned.
+ *
+ * Populations with at least EV_RADIX_MIN (or min_radix) individuals are
+ * sorted with an LSD radix sort over the fitness (EV_RADIX_BITS bits per
+ * pass), wich runs on all threads between the generations. 
+ *
+ * To EV_GRDY an EV_GASY can be added to run the greedy threads without
+ * synchronization: instead of joining all threads each generation and
+ * cloning the best greedy individual into all other threads, each thread
+ * publishes its improvements (fitness, owner and a version) and the other
+ * threads adopt the published best at the start of their next round if
+ * they can lock it without waiting. One generation is counted each time
+ * all threads together did num_threads rounds, and continue_ev is called
+ * from the thread which completed the generation. During the evolution
+ * population[0] is the greedy best of the first thread, which follows
+ * the global best, afterwards it is the best of all threads.
+ *
+ * To all of the combinations below one executor can be added, which
+ * runs the work of the threads (wich one is faster depends on the work):
+ *
+ *    EV_EXECUTOR_TCLIENT (EV_ETCL) the C-Utils thread clients (standart)
+ *    EV_EXECUTOR_PTHREAD (EV_EPTH) one new pthread for each thread and
+ *                                  generation
+ *    EV_EXECUTOR_POOL    (EV_EPOL) an pool of threads running during the
+ *                                  whole lifetime of the Evolution, which
+ *                                  are synchronized by a barrier: they spin
+ *                                  a while before they sleep on a futex
+ *                                  untill the next generation starts (the
+ *                                  main thread does the same while waiting
+ *                                  for the threads). The spin budget adapts
+ *                                  itself between EV_SPIN_MIN and 
+ *                                  EV_SPIN_MAX. This is usefull for small
+ *                                  populations or cheap fitness functions,
+ *                                  where the wakeup costs more than the
+ *                                  generation itself
+ *    EV_EXECUTOR_SERIAL  (EV_ESER) the work of all threads is done one
+ *                                  after the other by the calling thread 
+ *                                  (for debugging and to messure the 
+ *                                  parallel overhead)
+ *    EV_EXECUTOR_SHARED  (EV_ESHR) the threads of the EvPool given in the
+ *                                  args, wich can be shared by many
+ *                                  Evolutions running at the same time.
+ *                                  The work of each thread is one task of
+ *                                  the pool, the pool threads take the
+ *                                  tasks round robin from the Evolutions
+ *                                  and the thread waiting for an 
+ *                                  Evolution helps with its own tasks.
+ *                                  So num_threads is the number of tasks
+ *                                  per generation and not the number of 
+ *                                  threads in this case.
+ *
+ * The executor is only used if num_threads is greater than one.
+ * The executors are values within EV_EXECUTOR_MASK and not single bits,
+ * so only one of them can be added (EV_EPOL | EV_EPTH is EV_ESER).
+ *
+ * Together with the thread clients, the pool or the pthread executor
+ * an affinity can be added to pin each thread to one cpu:
+ *
+ *    EV_AFFINITY_NONE    (EV_ANON) the threads are not pinned (standart)
+ *    EV_AFFINITY_COMPACT (EV_ACMP) thread i runs on the i-th allowed cpu,
+ *                                  so the threads are close together
+ *    EV_AFFINITY_SCATTER (EV_ASCT) the threads are spread evenly over the
+ *                                  allowed cpus, wich on most machines
+ *                                  spreads them over the sockets
+ *    EV_AFFINITY_LIST    (EV_ALST) thread i runs on cpus[i % num_cpus]
+ *
+ * With an affinity the individuals and population slots are first 
+ * touched by the pinned thread wich initializes them, so the memory is
+ * spread over the NUMA nodes of the threads instead of being placed on
+ * the node of the main thread, and each thread moves its EvThreadArgs 
+ * to its node. A thread keeps its cpu during the whole evolution, but
+ * not the individuals it initialized: the generation slices differ from
+ * the init slices, chunks are stolen between the threads and the 
+ * selection permutes the population each generation.
+ *
  * Also an verbosytiy level of:
  *    EV_VERBOSE_QUIET    (EV_VEB0), 
  *    EV_VERBOSE_ONELINE  (EV_VEB1)
@@ -317,9 +877,46 @@ typedef struct {
   double   death_percentage;
   void     **opts;
   int      num_threads; 
-  uint16_t flags;
+  int      migration_interval;
+  int      migration_size;
+  int      migration_topology;
+  size_t   (*serialize_iv)   (void *, size_t, void *, void *);
+  void     (*deserialize_iv) (void *, const void *, size_t, void *);
+  const char *shm_name;
+  int      process_index;
+  EvPool   *pool;
+  const int *cpus;
+  int      num_cpus;
+  void     (*submit_fitness)   (Individual *, void *);
+  Individual *(*complete_fitness) (char, void *);
+  int      max_in_flight;
+  int      tournament_size;
+  int      min_quicksort;
+  int      chunks_per_thread;
+  int      min_radix;
+  void     (*init_iv_at) (void *, void *);
+  size_t   genome_size;
+  void     (*reinit_iv)  (void *, void *);
+  void     *(*alloc_iv)  (void *);
+  void     (*mutate_delta)  (Individual *, void *, void *);
+  int64_t  (*fitness_delta) (Individual *, void *, void *);
+  void     (*apply_delta)   (void *, void *, void *);
+  size_t   delta_size;
+  void     (*mutate_undoable) (Individual *, void *, void *);
+  void     (*undo)            (Individual *, void *, void *);
+  size_t   undo_size;
+  uint32_t flags;
 } EvInitArgs;
 
+/**
+ * An Individual wich fitness is calculated asynchronous 
+ * (see EV_ASYNC_FITNESS)
+ */
+typedef struct {
+  Individual *iv;         /* the submitted Individual                   */
+  int64_t    bound;       /* fitness it has to beat to be an improov    */
+} EvInFlight;
+
 /**
  * Struct holding information for the thread clients
  */
@@ -330,6 +927,19 @@ typedef struct {
   int       end;          /* individuals of the current working thread  */ 
   int       improovs;     /* improovs of the current thread             */
   void      *const opt;   /* opts for the current thread                */
+  int       next;         /* work-stealing cursors: the owner takes     */
+  int       last;         /* chunks from next, thiefs steal from last   */
+  pthread_mutex_t lock;   /* guards next and last (and the greedy best  */
+                          /* of the thread in async greedy mode)        */
+  void      *(*func) (void *); /* work of the current generation        */
+  uint64_t  start_ns;     /* time the thread started and finished       */
+  uint64_t  finish_ns;    /* its work of the last generation            */
+  int       spin;         /* adaptive spin budget of the spin barrier   */
+  int       cpu;          /* cpu to pin the thread to (or -1)           */
+  char      pinned;       /* set if the thread is already pinned        */
+  uint64_t  greedy_seen;  /* last version of the global best adopted    */
+  EvInFlight *in_flight;  /* individuals submitted by this thread       */
+  int       num_in_flight;/* number of submitted individuals            */
 } EvThreadArgs;
 
 /**
@@ -377,9 +987,221 @@ typedef struct {
  * | uint16_t verbose                   | the verbosity level, see flags      |
  * |                                    | describtion at EvInitArgs           |
  * |                                    |                                     |
+ * | char use_islands                   | indicates wether to use the island  |
+ * |                                    | model (see EV_USE_ISLANDS)          |
+ * |                                    |                                     |
+ * | int island_generations             | island model: number of generations |
+ * |                                    | the islands evolve before the next  |
+ * |                                    | migration                           |
+ * |                                    |                                     |
+ * | char partial_selection             | indicates wether to only partition  |
+ * |                                    | the survivors after a generation    |
+ * |                                    | (see EV_PARTIAL_SELECTION)          |
+ * |                                    |                                     |
+ * | char merge_selection               | indicates wether to merge the       |
+ * |                                    | sorted new individuals with the     |
+ * |                                    | survivors (see EV_MERGE_SELECTION)  |
+ * |                                    |                                     |
+ * | uint32_t parent_selection          | how to choose the parents (see      |
+ * |                                    | EV_PARENT_MASK)                     |
+ * |                                    |                                     |
+ * | int tournament_size                | tournament selection: number of     |
+ * |                                    | individuals of one tournament       |
+ * |                                    |                                     |
+ * | uint32_t *alias_prob               | proportional and rank selection:    |
+ * | int *alias_index                   | the alias table (choose parent i    |
+ * |                                    | with probability alias_prob[i] /    |
+ * |                                    | 2^31, else alias_index[i])          |
+ * |                                    |                                     |
+ * | double *alias_weights              | proportional and rank selection:    |
+ * | int *alias_work                    | temporary weights and work list to  |
+ * |                                    | build the alias table               |
+ * |                                    |                                     |
+ * | Individual **merged                | merge selection: merge buffer       |
+ * |                                    |                                     |
+ * | int *merge_runs                    | merge selection: bounds of the      |
+ * |                                    | sorted runs                         |
+ * |                                    |                                     |
+ * | uint32_t executor                  | the EV_EXECUTOR_* wich runs the     |
+ * |                                    | work of the threads                 |
+ * |                                    |                                     |
+ * | pthread_t *pthreads                | the threads of the pthread and pool |
+ * |                                    | executor                            |
+ * |                                    |                                     |
+ * | EvPool *pool                       | shared executor: the pool to use    |
+ * |                                    |                                     |
+ * | int pool_next                      | shared executor: the next task to   |
+ * |                                    | be taken by a thread                |
+ * |                                    |                                     |
+ * | int pool_remaining                 | shared executor: number of tasks    |
+ * |                                    | not finished yet                    |
+ * |                                    |                                     |
+ * | pthread_cond_t pool_done           | shared executor: signaled if all    |
+ * |                                    | tasks are finished                  |
+ * |                                    |                                     |
+ * | pthread_mutex_t mutex              | serializes the output and the calls |
+ * |                                    | of continue_ev of this Evolution    |
+ * |                                    |                                     |
+ * | EvAsync *async                     | the handle if the Evolution runs in |
+ * |                                    | the background, NULL otherwise      |
+ * |                                    |                                     |
+ * | int *cpus                          | the cpu of each thread, or NULL if  |
+ * |                                    | the threads are not pinned          |
+ * |                                    |                                     |
+ * | size_t ivs_space                   | size of ivs and population, wich    |
+ * | size_t population_space            | are mapped untouched if the threads |
+ * |                                    | are pinned (for the first touch)    |
+ * |                                    |                                     |
+ * | uint32_t bar_epoch                 | spin barrier: incremented by the    |
+ * |                                    | main thread to start an generation  |
+ * |                                    |                                     |
+ * | uint32_t bar_done                  | spin barrier: number of threads     |
+ * |                                    | finished with the generation        |
+ * |                                    |                                     |
+ * | uint32_t bar_sleepers              | spin barrier: number of threads     |
+ * |                                    | sleeping on bar_epoch / bar_done    |
+ * | uint32_t bar_main_sleeps           | (so the futex is only waked if      |
+ * |                                    | neccesary)                          |
+ * |                                    |                                     |
+ * | int bar_spin                       | spin barrier: spin budget of the    |
+ * |                                    | main thread                         |
+ * |                                    |                                     |
+ * | char bar_stop                      | spin barrier: set to stop threads   |
+ * |                                    |                                     |
+ * | uint64_t bar_release_ns            | time the current generation started |
+ * |                                    |                                     |
+ * | char use_processes                 | indicates wether this Evolution is  |
+ * |                                    | one process of an multi process     |
+ * |                                    | evolution (see EV_USE_PROCESSES)    |
+ * |                                    |                                     |
+ * | int num_processes                  | process mode: number of processes   |
+ * |                                    | sharing the memory region           |
+ * |                                    |                                     |
+ * | void *shm                          | process mode: the mapped shared     |
+ * |                                    | memory holding the migrant rings    |
+ * |                                    |                                     |
+ * | size_t shm_size                    | process mode: size of the mapping   |
+ * |                                    |                                     |
+ * | char steady_state                  | indicates wether to run in steady   |
+ * |                                    | state mode (see EV_STEADY_STATE)    |
+ * |                                    |                                     |
+ * | Individual **scratch               | steady state mode: one private      |
+ * |                                    | Individual per thread to produce    |
+ * |                                    | the next offspring in               |
+ * |                                    |                                     |
+ * | pthread_mutex_t *iv_locks          | steady state mode: one lock for     |
+ * |                                    | each slot of the population         |
+ * |                                    |                                     |
+ * | int64_t steady_born                | steady state mode: number of        |
+ * |                                    | offsprings produced so far          |
+ * |                                    |                                     |
+ * | int steady_improovs                | steady state mode: improovs during  |
+ * |                                    | the current generation              |
+ * |                                    |                                     |
+ * | char steady_stop                   | steady state mode: set if           |
+ * |                                    | continue_ev returned 0              |
+ * |                                    |                                     |
+ * | char async_fitness                 | indicates wether to calculate the   |
+ * |                                    | fitness asynchronous (see           |
+ * |                                    | EV_ASYNC_FITNESS)                   |
+ * |                                    |                                     |
+ * | char lazy_init                     | indicates wether to create the      |
+ * |                                    | deaths on first use (see            |
+ * |                                    | EV_LAZY_INIT)                       |
+ * |                                    |                                     |
+ * | void *alloc_iv(void *opts)         | lazy mode: allocates an individual  |
+ * |                                    | without initializing it             |
+ * |                                    |                                     |
+ * | char use_undo                      | indicates wether the greedy         |
+ * |                                    | candidates are mutated in place     |
+ * |                                    | (see EV_UNDO_MUTATION)              |
+ * |                                    |                                     |
+ * | char *undo_logs                    | undo mode: the undo buffer of each  |
+ * |                                    | thread                              |
+ * |                                    |                                     |
+ * | char use_delta                     | indicates wether the offsprings are |
+ * |                                    | patches (see EV_DELTA_OFFSPRING)    |
+ * |                                    |                                     |
+ * | char *deltas                       | delta mode: the patch of each       |
+ * | Individual **delta_parents         | individual (by its index in ivs)    |
+ * |                                    | and its parent (NULL if it is       |
+ * |                                    | materialized)                       |
+ * |                                    |                                     |
+ * | int delta_end                      | delta mode: end of the population   |
+ * |                                    | part the threads materialize        |
+ * |                                    |                                     |
+ * | char use_arena                     | indicates wether the genomes are    |
+ * |                                    | placed in slabs (see EV_ARENA)      |
+ * |                                    |                                     |
+ * | char pod_genome                    | indicates wether the genomes are    |
+ * |                                    | flat blobs (see EV_POD_GENOME)      |
+ * |                                    |                                     |
+ * | size_t genome_stride               | arena mode: distance of two genomes |
+ * |                                    | within a slab                       |
+ * |                                    |                                     |
+ * | char **arena                       | arena mode: the genome slabs (one   |
+ * | int arena_slabs                    | per thread slice of arena_ivs       |
+ * | int arena_ivs                      | individuals) or NULL                |
+ * |                                    |                                     |
+ * | Individual arena_best              | arena mode: copy of the best        |
+ * |                                    | individual returned by evolute      |
+ * |                                    | (outside of the arena)              |
+ * |                                    |                                     |
+ * | char greedy_async                  | indicates wether to run the greedy  |
+ * |                                    | threads without synchronization     |
+ * |                                    | (see EV_GREEDY_ASYNC)               |
+ * |                                    |                                     |
+ * | int64_t greedy_rounds              | async greedy mode: number of rounds |
+ * |                                    | started by all threads together     |
+ * |                                    |                                     |
+ * | int greedy_improovs                | async greedy mode: improovs during  |
+ * |                                    | the current generation              |
+ * |                                    |                                     |
+ * | char greedy_stop                   | async greedy mode: set if           |
+ * |                                    | continue_ev returned 0              |
+ * |                                    |                                     |
+ * | uint64_t greedy_version            | async greedy mode: incremented each |
+ * |                                    | time a better best is published     |
+ * |                                    |                                     |
+ * | int64_t greedy_fitness             | async greedy mode: fitness of the   |
+ * |                                    | published best                      |
+ * |                                    |                                     |
+ * | int greedy_owner                   | async greedy mode: the thread wich  |
+ * |                                    | published the best                  |
+ * |                                    |                                     |
+ * | pthread_mutex_t greedy_lock        | async greedy mode: guards version,  |
+ * |                                    | fitness and owner of the published  |
+ * |                                    | best, so they are allways changed   |
+ * |                                    | together                            |
+ * |                                    |                                     |
  * | int min_quicksort                  | min array length to change from     |
  * |                                    | quick to insertion sort             |
  * |                                    |                                     |
+ * | int chunks_per_thread              | number of chunks each thread slice  |
+ * |                                    | is split into                       |
+ * |                                    |                                     |
+ * | int min_radix                      | min population size to use the      |
+ * |                                    | radix sort                          |
+ * |                                    |                                     |
+ * | EvKey *keys                        | the fitness keys of the population  |
+ * |                                    | (sorted or partitioned instead of   |
+ * |                                    | the scattered Individuals)          |
+ * |                                    |                                     |
+ * | EvKey *radix_src                   | radix sort: the items sorted by the |
+ * | EvKey *radix_dst                   | last pass and the items of the      |
+ * |                                    | current pass                        |
+ * |                                    |                                     |
+ * | size_t *radix_counts               | radix sort: bucket counts (and then |
+ * |                                    | offsets) of each thread             |
+ * |                                    |                                     |
+ * | int radix_shift                    | radix sort: the bits of the current |
+ * | int radix_phase                    | pass and the work of the threads    |
+ * |                                    |                                     |
+ * | int chunk_size                     | number of individuals a thread      |
+ * |                                    | takes at once from its own or (when |
+ * |                                    | it runs out of work) an other       |
+ * |                                    | threads slice                       |
+ * |                                    |                                     |
  * | rand128_t **rands                  | array of random values              |
  * |                                    |                                     |
  * | int overall_start                  | indicates where to start repleacing |
@@ -399,6 +1221,7 @@ typedef struct {
  * | TClient *clients                   | Thread Clients which handle the     |
  * |                                    | threads used to calculate parallel, |
  * |                                    | saving syscalls by reusing threads  |
+ * |                                    | (only used by EV_EXECUTOR_TCLIENT)  |
  * |                                    |                                     |
  * | EvThreadArgs thread_args           | different argments for each thread  |
  * |                                    | containing an thread specific index |
@@ -440,11 +1263,61 @@ struct Evolution {
   const char     keep_last_generation;           
   const char     use_abort_requirement;          
   const char     use_greedy;          
+  const char     steady_state;
+  const char     use_islands;
+  const int      migration_interval;
+  const int      migration_size;
+  const int      migration_topology;
+        int      island_generations;
+  const char     partial_selection;
+  const char     merge_selection;
+  const uint32_t parent_selection;
+  const int      tournament_size;
+  uint32_t       *alias_prob;
+  int            *alias_index;
+  double         *alias_weights;
+  int            *alias_work;
+  Individual     **merged;
+  int            *merge_runs;
+  const uint32_t executor;
+  pthread_t      *pthreads;
+  EvPool         *const pool;
+  int            pool_next;
+  int            pool_remaining;
+  pthread_cond_t pool_done;
+  pthread_mutex_t mutex;
+  EvAsync        *async;
+  int            *const cpus;
+  size_t         ivs_space;
+  size_t         population_space;
+  uint32_t       bar_epoch;
+  uint32_t       bar_done;
+  uint32_t       bar_sleepers;
+  uint32_t       bar_main_sleeps;
+  int            bar_spin;
+  char           bar_stop;
+  uint64_t       bar_release_ns;
+  size_t         (*const serialize_iv)   (void *, size_t, void *, void *);
+  void           (*const deserialize_iv) (void *, const void *, size_t, void *);
+  const char     use_processes;
+  const int      process_index;
+  const int      num_processes;
+  void           *shm;
+  size_t         shm_size;
   const int      deaths;
   const int      survivors;
   const char     sort_max;                     
   const uint16_t verbose;                  
   const int      min_quicksort;              
+  const int      chunks_per_thread;
+  const int      min_radix;
+  EvKey          *keys;
+  EvKey          *radix_src;
+  EvKey          *radix_dst;
+  size_t         *radix_counts;
+  int            radix_shift;
+  int            radix_phase;
+        int      chunk_size;
   void *const    *const opts;   
   const int      num_threads; 
   rand128_t      **rands;
@@ -453,6 +1326,48 @@ struct Evolution {
   const uint32_t i_mut_propability;
   TClient *const thread_clients;
   EvThreadArgs   *const *const thread_args;
+  Individual     **scratch;
+  pthread_mutex_t *iv_locks;
+  int64_t        steady_born;
+  int            steady_improovs;
+  char           steady_stop;
+  const char     async_fitness;
+  void           (*const submit_fitness)   (Individual *, void *);
+  Individual     *(*const complete_fitness) (char, void *);
+  const int      max_in_flight;
+  const char     lazy_init;
+  void           *(*const alloc_iv) (void *);
+  void           (*const reinit_iv) (void *, void *);
+  const char     use_undo;
+  void           (*const mutate_undoable) (Individual *, void *, void *);
+  void           (*const undo)            (Individual *, void *, void *);
+  const size_t   undo_size;
+  char           *undo_logs;
+  const char     use_delta;
+  void           (*const mutate_delta)  (Individual *, void *, void *);
+  int64_t        (*const fitness_delta) (Individual *, void *, void *);
+  void           (*const apply_delta)   (void *, void *, void *);
+  const size_t   delta_size;
+  char           *deltas;
+  Individual     **delta_parents;
+  int            delta_end;
+  const char     use_arena;
+  const char     pod_genome;
+  void           (*const init_iv_at) (void *, void *);
+  const size_t   genome_size;
+  const size_t   genome_stride;
+  char           **arena;
+  int            arena_slabs;
+  int            arena_ivs;
+  Individual     arena_best;
+  const char     greedy_async;
+  int64_t        greedy_rounds;
+  int            greedy_improovs;
+  char           greedy_stop;
+  uint64_t       greedy_version;
+  int64_t        greedy_fitness;
+  int            greedy_owner;
+  pthread_mutex_t greedy_lock;
   EvolutionInfo  info;
 };
 
@@ -477,6 +1392,100 @@ Evolution  *new_evolution(EvInitArgs *args);
  */
 Individual *evolute(Evolution *ev);
 
+/**
+ * Starts evolute for the given Evolution in a new thread and 
+ * returns a handle to controll it, or NULL if the thread 
+ * couldn't be started
+ */
+EvAsync *evolute_async(Evolution *ev);
+
+/**
+ * Returns 1 if the evolution of the given handle is finished
+ */
+char ev_async_poll(EvAsync *async);
+
+/**
+ * Waits untill the evolution of the given handle is finished,
+ * frees the handle and returns the best Individual
+ */
+Individual *ev_async_wait(EvAsync *async);
+
+/**
+ * Stops the evolution of the given handle at the next generation
+ * (ev_async_wait has to be called anyway)
+ */
+void ev_async_cancel(EvAsync *async);
+
+/**
+ * Clones the best Individual of the running evolution into dst 
+ * (dst->iv must be an initialized individual) and returns the 
+ * generation it was taken at
+ *
+ * Note: the snapshot is taken by the evolution at the next generation 
+ *       (in steady state mode without stopping the other threads,
+ *       in the island model at the next migration), so this blocks at 
+ *       most for one generation
+ */
+int ev_async_snapshot_best(EvAsync *async, Individual *dst);
+
+/**
+ * Sorts the whole population of the given Evolution by fitness 
+ * (with EV_PARTIAL_SELECTION only the best individual is in place 
+ * after a generation, e.g. continue_ev can call this to get the ranks)
+ *
+ * Note: with EV_LAZY_INIT nothing is done before the first generation,
+ *       the initialized parents are sorted then and the others have no 
+ *       genome yet
+ */
+void ev_rank(Evolution *ev);
+
+/**
+ * Runs num_runs evolutions (e.g. with different seeds or configurations)
+ * at the same time on one pool of num_threads threads and returns the
+ * best Individual of all runs
+ *
+ * Every check_ms milliseconds the best fitness of each run is compared 
+ * with the leading run, runs wich are worse by more than tolerance 
+ * (relative to the fitness of the leader) are cancelled, so the pool
+ * threads work for the remaining runs
+ *
+ * Note: the runs use copies of the args with the executor replaced by
+ *       EV_EXECUTOR_SHARED (the args themselves are not changed), so 
+ *       num_threads of each args is its number of tasks per generation
+ *       (use the pool size to let the last run use all threads). Each
+ *       args needs its own opts.
+ *
+ * Note: if num_runs, num_threads or check_ms is less than one (or no 
+ *       run could be started) the returned Individual has a NULL iv
+ */
+Individual ev_portfolio(EvInitArgs *args, 
+                        int num_runs, 
+                        int num_threads, 
+                        int check_ms,
+                        double tolerance);
+
+/**
+ * Tunes num_threads, the executor, chunks_per_thread, min_quicksort and
+ * min_radix of the given args by running short evolutions of generations 
+ * generations with each setting (one after the other, using the 
+ * callbacks of the args) and writes back the fastest settings 
+ * (together with EV_USE_TUNING). Returns 0 if the args are invalid
+ *
+ * If cache is not NULL the settings are stored in this file, keyed 
+ * by a signature of the args, the number of cpus and the given key
+ * (e.g. the name and size of the problem, may be NULL), so the next 
+ * call with the same signature only reads them
+ *
+ * Note: num_threads of the args is the maximum number of threads
+ *       (opts needs one entry per thread), the abort requirement and
+ *       the verbosity are disabled during the test runs. Not usable
+ *       with EV_USE_PROCESSES or EV_EXECUTOR_SHARED
+ */
+int ev_autotune(EvInitArgs *args, 
+                int generations, 
+                const char *cache, 
+                const char *key);
+
 /**
  * Computes an evolution for the given args
  * and returns the best Individual
@@ -508,5 +1517,36 @@ uint64_t ev_size(int population_size,
  */
 void ev_inspect(Evolution *ev);
 
+/**
+ * Returns a new thread pool with num_threads threads, wich can be
+ * shared by many Evolutions (see EV_EXECUTOR_SHARED)
+ */
+EvPool *new_ev_pool(int num_threads);
+
+/**
+ * Stops the threads and frees the given pool
+ * Note: all Evolutions using the pool have to be cleaned up before
+ */
+void ev_pool_free(EvPool *pool);
+
+/**
+ * Starts num_processes processes for an multi process evolution 
+ * (see EV_USE_PROCESSES) and waits until they are finished
+ *
+ * A shared memory region named shm_name is created to exchange 
+ * migrants of at most migrant_size (> 0) bytes, each process is pinned to 
+ * its own set of cpus and calls run with its process index and arg
+ * (run should create and evolute an Evolution with EV_PROC set and
+ * return the exit status of the process)
+ *
+ * Returns 0 if all processes exited with 0, the number of failed 
+ * processes otherwise or -1 if the processes couldn't be started
+ */
+int ev_launch_processes(const char *shm_name,
+                        int num_processes,
+                        size_t migrant_size,
+                        int (*run) (int, void *),
+                        void *arg);
+
 
 #endif // end of EVOLUTION_HEADER
@@ -11,16 +11,21 @@ typedef struct {
   uint32_t rand;
 } ThreadArgs;
 
-void *init_v(void *opts) {
+void init_v_at(void *genome, void *opts) {
 
   ThreadArgs *args = opts;
-  int i;
-
-  int *ary = malloc(sizeof(int) * args->length);
+  int i, *ary = genome;
 
   for (i = 0; i < args->length; i++)
     ary[i] = rand32(&args->rand) - (RAND_MAX / 2);
+}
+
+void *init_v(void *opts) {
 
+  ThreadArgs *args = opts;
+  int *ary = malloc(sizeof(int) * args->length);
+
+  init_v_at(ary, opts);
   return ary;
 }
 
@@ -81,9 +86,10 @@ int64_t fittnes_v(Individual *src, void *opts) {
 
 int main(int argc, char *argv[]) {
 
-  if (argc != 6) {
+  if (argc < 6 || argc > 7) {
     printf("%s <num generations> <num threads> <verbose level(0-3)> "
-           "<num ivs> <length>\n", 
+           "<num ivs> <length> [genome(0 = callbacks, 1 = pod, "
+           "2 = pod in an arena)]\n", 
            argv[0]);
     exit(1);
   }
@@ -125,6 +131,19 @@ int main(int argc, char *argv[]) {
   args.num_threads          = atoi(argv[2]);
   args.flags                = EV_UREC|EV_UMUT|EV_AMUT|EV_KEEP|verbose;
 
+  /* the int arrays are flat, so the Evolution can clone them */
+  if (argc == 7 && atoi(argv[6]) > 0) {
+    args.clone_iv    = NULL;
+    args.free_iv     = NULL;
+    args.genome_size = sizeof(int) * length;
+    args.flags |= EV_PODG;
+  }
+
+  if (argc == 7 && atoi(argv[6]) == 2) {
+    args.init_iv_at = init_v_at;
+    args.flags |= EV_ARNA;
+  }
+
   Evolution *ev = new_evolution(&args);
   best = evolute(ev);
 
@@ -109,8 +109,10 @@ int64_t fittnes_v(Individual *src, void *opts) {
 
 int main(int argc, char *argv[]) {
 
-  if (argc != 4) {
-    printf("%s <num generations> <num threads> <verbose level(0-3)>\n", 
+  if (argc < 4 || argc > 6) {
+    printf("%s <num generations> <num threads> <verbose level(0-3)> "
+           "[executor(0 = thread clients, 1 = pool, 2 = pthread, "
+           "3 = serial)] [affinity(0 = none, 1 = compact, 2 = scatter)]\n", 
            argv[0]);
     exit(1);
   }
@@ -124,6 +126,23 @@ int main(int argc, char *argv[]) {
     default : verbose = EV_VEB0; 
   }
 
+  int executor = EV_ETCL;
+
+  switch (argc >= 5 ? atoi(argv[4]) : 0) {
+    case 1:   executor = EV_EPOL; break;
+    case 2:   executor = EV_EPTH; break;
+    case 3:   executor = EV_ESER; break;
+    default : executor = EV_ETCL; 
+  }
+
+  int affinity = EV_ANON;
+
+  switch (argc == 6 ? atoi(argv[5]) : 0) {
+    case 1:   affinity = EV_ACMP; break;
+    case 2:   affinity = EV_ASCT; break;
+    default : affinity = EV_ANON; 
+  }
+
   Individual best;
   void **opts = malloc(sizeof(void *) * TEST_NUM_IVS);
 
@@ -147,7 +166,8 @@ int main(int argc, char *argv[]) {
   args.death_percentage     = 0.5;
   args.opts                 = opts;
   args.num_threads          = atoi(argv[2]);
-  args.flags                = EV_UREC|EV_UMUT|EV_AMUT|EV_KEEP|verbose;
+  args.flags                = EV_UREC|EV_UMUT|EV_AMUT|EV_KEEP|verbose|
+                              executor|affinity;
 
   best = best_evolution(&args);;
 
@@ -6,22 +6,53 @@
 #define __TSP__
 
 #include "tsp.h"
+#include <unistd.h>
 
 /* functions */
 TSP *new_tsp(uint32_t length);
+void free_tsp(TSP *tsp);
 void init_tsp_ev(TSPEvolution *tsp_ev, TSP *tsp);
+void free_tsp_ev(TSPEvolution *tsp_ev);
 void *init_tsp_route(void *opts);
+void *alloc_tsp_route(void *opts);
+void init_tsp_route_at(void *genome, void *opts);
+void reinit_tsp_route(void *v_route, void *opts);
+size_t tsp_route_size(uint32_t length);
 void clone_tsp_route(void *v_dst, void *v_src, void *opts);
 void free_tsp_route(void *v_src, void *opts);
+void free_tsp_route_at(void *v_src, void *opts);
 void mutate_tsp_route(Individual *iv, void *opts);
 void mutate_tsp_route_reinit(Individual *iv, void *opts);
 void mutate_tsp_route_switch(Individual *iv, void *opts);
+void mutate_tsp_route_delta(Individual *parent, void *v_delta, void *opts);
+int64_t tsp_route_length_delta(Individual *parent, 
+                               void *v_delta, 
+                               void *opts);
+void apply_tsp_route_delta(void *v_route, void *v_delta, void *opts);
+void mutate_tsp_route_undoable(Individual *iv, void *v_undo, void *opts);
+void undo_tsp_route(Individual *iv, void *v_undo, void *opts);
 int64_t tsp_route_length(Individual *iv, void *opts);
 void recombinate_tsp_route(Individual *src_1,
                             Individual *src_2,
                             Individual *dst,
                             void *opts);
+size_t serialize_tsp_route(void *buf, size_t size, void *v_src, void *opts);
+void deserialize_tsp_route(void *v_dst, 
+                           const void *buf, 
+                           size_t size, 
+                           void *opts);
 char tsp_continue_ev(Evolution *const ev);
+char tsp_check_continue_ev(Evolution *const ev);
+char check_tsp_route(Individual *iv, TSPEvolution *tsp_ev);
+char check_tsp_population(Evolution *ev, int n_ivs, char sorted);
+char check_tsp_async(TSPEvolution **opts, int n_threads);
+char check_tsp_selection(Evolution *ev);
+char check_tsp_patches(TSPEvolution *tsp_ev, int n);
+char check_tsp_parents(uint32_t selection, int n_generations);
+void submit_tsp_route_length(Individual *iv, void *opts);
+Individual *complete_tsp_route_length(char wait, void *opts);
+int tsp_process(int index, void *arg);
+void *tsp_shared(void *arg);
 
 /**
  * main method to start the tsp test
@@ -31,7 +62,16 @@ int main(int argc, char *argv[]) {
   /* cmd args check */
   if (argc != 7) {
     printf("%s <num citys> <generation limit> <num ivs> "
-            "<num threads> <verbose(0-3)> <greedy>\n", argv[0]);
+            "<num threads> <verbose(0-3)> "
+            "<mode(0 = normal, 1 = greedy, 2 = steady state, 3 = islands, "
+            "4 = processes, 6 = pool executor, "
+            "7 = shared pool, 8 = async, 9 = async greedy, "
+            "10 = async fitness, 11 = portfolio, 12 = lazy init, "
+            "13 = autotune, 14 = partial selection, "
+            "15 = merge selection, 16 = radix sort, 17 = tournament, "
+            "18 = proportional, 19 = rank, 20 = arena, "
+            "21 = greedy reinit, 22 = delta offsprings, "
+            "23 = greedy undo, 24 = lazy partial selection)>\n", argv[0]);
     exit(1);
   }
 
@@ -48,7 +88,7 @@ int main(int argc, char *argv[]) {
   int n_ivs           = atoi(argv[3]);
   int n_generations   = atoi(argv[2]);
   int n_citys         = atoi(argv[1]);
-  char greedy         = atoi(argv[6]);
+  int mode            = atoi(argv[6]);
   TSP *tsp            = new_tsp(n_citys);
   TSPEvolution **opts = malloc(sizeof(TSPEvolution *) * n_threads);
 
@@ -77,15 +117,349 @@ int main(int argc, char *argv[]) {
   args.num_threads          = n_threads;
   args.flags                = EV_UMUT|EV_AMUT|EV_ABRT|EV_KEEP|verbose;
 
-  if (greedy) {
+  if (mode == 1 || mode == 9 || mode == 21 || mode == 23) {
     args.greedy_individuals = n_ivs;
     args.greedy_size = n_ivs / (n_threads * 2);
     args.flags = EV_GRDY|EV_UMUT|EV_AMUT|verbose;
   }
 
+  if (mode == 9)
+    args.flags |= EV_GASY;
+
+  /* the offsprings are switch patches of their parents */
+  if (mode == 22) {
+    args.mutate_delta  = mutate_tsp_route_delta;
+    args.fitness_delta = tsp_route_length_delta;
+    args.apply_delta   = apply_tsp_route_delta;
+    args.delta_size    = sizeof(TSPDelta);
+    args.flags |= EV_DLTA;
+  }
+
+  /* the greedy candidates are calculated in place */
+  if (mode == 21) {
+    args.reinit_iv = reinit_tsp_route;
+    args.flags |= EV_RINI;
+  }
+
+  /* the greedy candidates are switched and reverted in place */
+  if (mode == 23) {
+    args.mutate_undoable = mutate_tsp_route_undoable;
+    args.undo            = undo_tsp_route;
+    args.undo_size       = sizeof(TSPDelta);
+    args.flags |= EV_UNDO;
+  }
+
+  /* the patches have to match the in place switches */
+  if ((mode == 22 || mode == 23) && !check_tsp_patches(opts[0], 1000)) {
+    printf("patched routes differ from the switched ones\n");
+    exit(1);
+  }
+
+  if (mode == 10) {
+    args.submit_fitness   = submit_tsp_route_length;
+    args.complete_fitness = complete_tsp_route_length;
+    args.max_in_flight    = TSP_MAX_PENDING;
+    args.flags |= EV_AFIT;
+  }
+
+  if (mode == 2)
+    args.flags |= EV_STST;
+
+  if (mode == 12 || mode == 24) {
+    args.alloc_iv = alloc_tsp_route;
+    args.flags |= EV_LAZY;
+  }
+
+  /* compare each selection with a full sort */
+  if (mode == 0 || (mode >= 14 && mode <= 16))
+    args.continue_ev = tsp_check_continue_ev;
+
+  if (mode == 14 || mode == 24)
+    args.flags |= EV_PSEL;
+
+  if (mode == 15)
+    args.flags |= EV_MSEL;
+
+  /* sort allways with the radix sort */
+  if (mode == 16) {
+    args.min_quicksort     = EV_QICKSORT_MIN;
+    args.chunks_per_thread = EV_CHUNKS_PER_THREAD;
+    args.min_radix         = 1;
+    args.flags |= EV_TUNE;
+  }
+
+  /* with more deaths than survivors the parents are choosen randomly */
+  if (mode >= 17 && mode <= 19)
+    args.death_percentage = 0.75;
+
+  if (mode == 17) {
+    args.tournament_size = 3;
+    args.flags |= EV_PTRN;
+  }
+
+  if (mode == 18)
+    args.flags |= EV_PPRP;
+
+  if (mode == 19)
+    args.flags |= EV_PRNK;
+
+  /* the picks on a fixed population have to match the weights */
+  if ((mode == 18 || mode == 19) && 
+      !check_tsp_parents(args.flags & (EV_PPRP|EV_PRNK), 5000)) {
+    printf("parent picks differ from the selection weights\n");
+    exit(1);
+  }
+
+  /* all routes in the slabs of the Evolution */
+  if (mode == 20) {
+    args.init_iv_at  = init_tsp_route_at;
+    args.genome_size = tsp_route_size(n_citys);
+    args.free_iv     = free_tsp_route_at;
+    args.flags |= EV_ARNA;
+  }
+
+  if (mode == 3) {
+    args.migration_interval = 10;
+    args.migration_size     = 2;
+    args.migration_topology = EV_MIGRATE_RING;
+    args.flags |= EV_ISLE;
+  }
+
+  if (mode == 6)
+    args.flags |= EV_EPOL;
+
+  /* two processes exchanging migrants over shared memory */
+  if (mode == 4) {
+    char shm_name[64];
+    sprintf(shm_name, "/tsp-evolution-%d", (int) getpid());
+
+    args.migration_interval = 10;
+    args.migration_size     = 2;
+    args.serialize_iv       = serialize_tsp_route;
+    args.deserialize_iv     = deserialize_tsp_route;
+    args.shm_name           = shm_name;
+    args.flags |= EV_PROC;
+
+    return ev_launch_processes(shm_name, 
+                               2, 
+                               sizeof(TSPRoad) * n_citys, 
+                               tsp_process, 
+                               &args);
+  }
+
+  /* four seeds racing each other, the losers are stoped early */
+  if (mode == 11) {
+    EvInitArgs runs[4];
+    int j;
+
+    for (j = 0; j < 4; j++) {
+      runs[j]      = args;
+      runs[j].opts = malloc(sizeof(TSPEvolution *) * n_threads);
+
+      for (i = 0; i < n_threads; i++) {
+        TSPEvolution *tsp_ev = malloc(sizeof(TSPEvolution));
+        tsp_ev->index = i;
+        tsp_ev->rand  = new_rand128(time(NULL) ^ i ^ (j << 8));
+        init_tsp_ev(tsp_ev, tsp);
+        runs[j].opts[i] = tsp_ev;
+      }
+    }
+
+    /* invalid runs or threads may not start anything */
+    if (ev_portfolio(runs, 0, n_threads, 2, 0.05).iv != NULL ||
+        ev_portfolio(runs, 4, 0, 2, 0.05).iv != NULL) {
+      printf("invalid portfolio args accepted\n");
+      exit(1);
+    }
+
+    Individual winner = ev_portfolio(runs, 4, n_threads, 2, 0.05);
+
+    #ifndef NO_OUTPUT
+    printf("portfolio shortest found path: %" PRIi64 "\n", winner.fitness);
+    #endif
+
+    if (winner.iv == NULL || !check_tsp_route(&winner, runs[0].opts[0])) {
+      printf("invalid portfolio winner\n");
+      exit(1);
+    }
+
+    free_tsp_route(winner.iv, runs[0].opts[0]);
+
+    for (j = 0; j < 4; j++) {
+      for (i = 0; i < n_threads; i++) {
+        free_tsp_ev(runs[j].opts[i]);
+        free(runs[j].opts[i]);
+      }
+
+      free(runs[j].opts);
+    }
+
+    for (i = 0; i < n_threads; i++) {
+      free_tsp_ev(opts[i]);
+      free(opts[i]);
+    }
+
+    free(opts);
+    free_tsp(tsp);
+    return 0;
+  }
+
+  /* four Evolutions sharing the threads of one pool */
+  if (mode == 7) {
+    EvPool *pool = new_ev_pool(n_threads);
+    EvInitArgs shared_args[4];
+    pthread_t threads[4];
+    int j;
+
+    for (j = 0; j < 4; j++) {
+      shared_args[j]       = args;
+      shared_args[j].opts  = malloc(sizeof(TSPEvolution *) * n_threads);
+      shared_args[j].pool  = pool;
+      shared_args[j].flags |= EV_ESHR;
+
+      for (i = 0; i < n_threads; i++) {
+        TSPEvolution *tsp_ev = malloc(sizeof(TSPEvolution));
+        tsp_ev->index = i;
+        tsp_ev->rand  = new_rand128(time(NULL) ^ i ^ (j << 8));
+        init_tsp_ev(tsp_ev, tsp);
+        shared_args[j].opts[i] = tsp_ev;
+      }
+
+      pthread_create(&threads[j], NULL, tsp_shared, &shared_args[j]);
+    }
+
+    for (j = 0; j < 4; j++)
+      pthread_join(threads[j], NULL);
+
+    ev_pool_free(pool);
+    return 0;
+  }
+
+  /* tune the settings with some short runs (cached for the next time) */
+  if (mode == 13) {
+    char key[32], dir[] = "tsp-autotune-XXXXXX", cache[64];
+    EvInitArgs cached = args;
+    snprintf(key, sizeof(key), "tsp %d %d", n_citys, n_ivs);
+
+    /* a fresh cache for each run, so earlier runs don't matter */
+    if (mkdtemp(dir) == NULL) {
+      perror("mkdtemp");
+      exit(1);
+    }
+    snprintf(cache, sizeof(cache), "%s/cache", dir);
+    
+    if (!ev_autotune(&args, 5, cache, key))
+      exit(1);
+
+    /* the second run has to take the settings from the cache */
+    if (!ev_autotune(&cached, 5, cache, key))
+      exit(1);
+
+    /* an entry with non executor bits in front may not be used */
+    EvInitArgs polluted = args;
+    char line[128];
+    FILE *file = fopen(cache, "r");
+    if (file == NULL || fgets(line, sizeof(line), file) == NULL) {
+      perror("cache");
+      exit(1);
+    }
+    fclose(file);
+
+    unsigned long long signature = strtoull(line, NULL, 16);
+    file = fopen(cache, "w");
+    fprintf(file, "%llx %d %u %d %d %d\n%s", 
+            signature, 1, 1u, 1, 1, 1, line);
+    fclose(file);
+
+    if (!ev_autotune(&polluted, 5, cache, key) || 
+        polluted.flags != args.flags) {
+      printf("polluted cache entry accepted\n");
+      exit(1);
+    }
+
+    unlink(cache);
+    rmdir(dir);
+
+    if (args.num_threads < 1 || args.num_threads > n_threads ||
+        !(args.flags & EV_TUNE) ||
+        (args.flags & EV_EXECUTOR_MASK) >= EV_EXECUTOR_SHARED ||
+        args.chunks_per_thread < 1 || args.min_quicksort < 1 || 
+        args.min_radix < 1) {
+
+      printf("invalid tuned settings\n");
+      exit(1);
+    }
+
+    if (cached.num_threads       != args.num_threads       ||
+        cached.flags             != args.flags             ||
+        cached.chunks_per_thread != args.chunks_per_thread ||
+        cached.min_quicksort     != args.min_quicksort     ||
+        cached.min_radix         != args.min_radix) {
+
+      printf("cached settings differ from the tuned ones\n");
+      exit(1);
+    }
+  }
+
   Individual *best;
   Evolution *ev = new_evolution(&args);
-  best = evolute(ev);
+
+  if (ev == NULL) {
+    printf("invalid args\n");
+    exit(1);
+  }
+
+  /* take some snapshots while the evolution runs in the background */
+  if (mode == 8) {
+    TSPEvolution snap_opt;
+    Individual snap;
+
+    snap_opt.index = n_threads;
+    snap_opt.rand  = new_rand128(time(NULL) ^ n_threads);
+    init_tsp_ev(&snap_opt, tsp);
+    snap.iv = init_tsp_route(&snap_opt);
+
+    EvAsync *async = evolute_async(ev);
+    int epoch = 0;
+
+    for (i = 0; i < 5 && !ev_async_poll(async); i++) {
+      usleep(1000);
+      epoch = ev_async_snapshot_best(async, &snap);
+
+      #ifndef NO_OUTPUT
+      printf("snapshot at generation %d: %" PRIi64 "\n", 
+             epoch, 
+             snap.fitness);
+      #endif
+    }
+
+    ev_async_cancel(async);
+    best = ev_async_wait(async);
+    (void) epoch;
+
+    free_tsp_route(snap.iv, &snap_opt);
+    free_tsp_ev(&snap_opt);
+  } else
+    best = evolute(ev);
+
+  if (!check_tsp_route(best, opts[0])) {
+    printf("invalid best route\n");
+    exit(1);
+  }
+
+  /* no Individual may be lost or duplicated */
+  if ((mode == 0 || mode == 2 || mode == 3 || mode == 10 || 
+       (mode >= 14 && mode <= 16) || mode == 22) &&
+      !check_tsp_population(ev, n_ivs, mode != 2 && mode != 3)) {
+    printf("invalid population\n");
+    exit(1);
+  }
+
+  if (mode == 10 && !check_tsp_async(opts, n_threads)) {
+    printf("not all submitted routes were completed\n");
+    exit(1);
+  }
+
   TSPRoute *route = best->iv;
 
   if (n_citys <= 40) {
@@ -106,13 +480,13 @@ int main(int argc, char *argv[]) {
    * calculate the improvve in comparison with an random route
    */
   uint32_t rand_fitness = 0;
-  for (i = 0; i < n_generations; i++) {
+  for (i = 0; i < n_generations || i == 0; i++) {
     Individual iv;
     iv.iv = init_tsp_route(opts[0]);
     rand_fitness += tsp_route_length(&iv, opts[0]);
     free_tsp_route(iv.iv, opts[0]);
   }
-  rand_fitness /= n_generations;
+  rand_fitness /= i;
 
   printf("improov in comparison to an average "
          "random route (%" PRIu32 "): %f\n",
@@ -140,6 +514,7 @@ int main(int argc, char *argv[]) {
   (void) route;
   #endif
 
+  free_tsp(tsp);
   return 0;
 
 }
@@ -213,6 +588,9 @@ void init_tsp_ev(TSPEvolution *tsp_ev, TSP *tsp) {
 
 
   tsp_ev->mut_size_reduce = 0.0;
+  tsp_ev->num_pending     = 0;
+  tsp_ev->num_submitted   = 0;
+  tsp_ev->num_completed   = 0;
 
   ARY_INIT(uint32_t, tsp_ev->citys, tsp->length);
   ARY_INIT(uint32_t, tsp_ev->tmp, tsp->length);
@@ -223,6 +601,35 @@ void init_tsp_ev(TSPEvolution *tsp_ev, TSP *tsp) {
   
 }
 
+/**
+ * frees an given TSP
+ */
+void free_tsp(TSP *tsp) {
+
+  uint32_t x;
+  for (x = 0; x < tsp->length; x++)
+    free(tsp->distances[x]);
+
+  free(tsp->distances);
+  free(tsp);
+}
+
+/**
+ * frees the copy of the tsp, the arrays and the random 
+ * state of an given TSPEvolution (but not the struct itself)
+ */
+void free_tsp_ev(TSPEvolution *tsp_ev) {
+
+  uint32_t x;
+  for (x = 0; x < tsp_ev->tsp.length; x++)
+    free(tsp_ev->tsp.distances[x]);
+
+  free(tsp_ev->tsp.distances);
+  free(&ARY_AT(tsp_ev->citys, 0));
+  free(&ARY_AT(tsp_ev->tmp, 0));
+  free(tsp_ev->rand);
+}
+
 /**
  * functions for sorting the TSPRoads pointer array
  * by city_a index
@@ -238,26 +645,14 @@ static inline char roads_equal(TSPRoad *a, TSPRoad *b) {
 }
 
 /**
- * int an TSPRoute for a given TSPEvolution
+ * calculates an random TSPRoute for a given TSPEvolution
  * Note: in the TSP Evolution an individual is represented by an Road
  *
  * complexity is in O(n) 
  * n = route->length
  */
-void *init_tsp_route(void *opts) {
-  
-  TSPEvolution *tsp_ev = opts;
+static void random_tsp_route(TSPRoute *route, TSPEvolution *tsp_ev) {
 
-  /**
-   * init new Route
-   * length is num citys + 1 because we must travel
-   * back to start city
-   */
-  TSPRoute *route = malloc(sizeof(TSPRoute));
-  route->length   = tsp_ev->tsp.length; 
-  route->roads    = malloc(sizeof(TSPRoad) * route->length);
-  route->citys    = malloc(sizeof(TSPRoad *) * route->length);
- 
   /**
    * clone citys to choose a route randomly by extracting
    * citys from temp array
@@ -299,10 +694,94 @@ void *init_tsp_route(void *opts) {
    */
   for (i = 0; i < route->length; i++)
     route->citys[route->roads[i].city_a] = &route->roads[i];
+}
+
+/**
+ * int an TSPRoute for a given TSPEvolution
+ *
+ * complexity is in O(n) 
+ * n = route->length
+ */
+void *init_tsp_route(void *opts) {
+  
+  TSPRoute *route = alloc_tsp_route(opts);
+
+  random_tsp_route(route, opts);
+  return route;
+}
+
+/**
+ * allocates an TSPRoute for a given TSPEvolution 
+ * without calculating its roads (lazy init)
+ *
+ * complexity is in O(1) 
+ */
+void *alloc_tsp_route(void *opts) {
+  
+  TSPEvolution *tsp_ev = opts;
+
+  /**
+   * init new Route
+   * length is num citys + 1 because we must travel
+   * back to start city
+   */
+  TSPRoute *route = malloc(sizeof(TSPRoute));
+  route->length   = tsp_ev->tsp.length; 
+  route->roads    = malloc(sizeof(TSPRoad) * route->length);
+  route->citys    = malloc(sizeof(TSPRoad *) * route->length);
 
   return route;
 }
 
+/**
+ * overrides an given TSPRoute with an random one
+ *
+ * complexity is in O(n) 
+ * n = route->length
+ */
+void reinit_tsp_route(void *v_route, void *opts) {
+  random_tsp_route(v_route, opts);
+}
+
+/**
+ * bytes of the roads of an TSPRoute placed in one buffer
+ * (padded so that the city pointers behind them are aligned)
+ */
+#define TSP_ROADS_SIZE(LENGTH)                                              \
+  ((sizeof(TSPRoad) * (LENGTH) + sizeof(TSPRoad *) - 1) /                   \
+   sizeof(TSPRoad *) * sizeof(TSPRoad *))
+
+/**
+ * returns the bytes of an TSPRoute with the given length
+ * placed in one buffer (see init_tsp_route_at)
+ */
+size_t tsp_route_size(uint32_t length) {
+  return sizeof(TSPRoute) + 
+         TSP_ROADS_SIZE(length) + 
+         sizeof(TSPRoad *) * length;
+}
+
+/**
+ * int an TSPRoute for a given TSPEvolution in the given buffer
+ * of tsp_route_size bytes: the route followed by its roads
+ * and its city pointers
+ *
+ * complexity is in O(n) 
+ * n = route->length
+ */
+void init_tsp_route_at(void *genome, void *opts) {
+  
+  TSPEvolution *tsp_ev = opts;
+  TSPRoute *route      = genome;
+
+  route->length = tsp_ev->tsp.length; 
+  route->roads  = (TSPRoad *) (route + 1);
+  route->citys  = (TSPRoad **) ((char *) route->roads + 
+                                TSP_ROADS_SIZE(route->length));
+
+  random_tsp_route(route, tsp_ev);
+}
+
 /**
  * clones an given TSPRoute
  *
@@ -341,6 +820,17 @@ void free_tsp_route(void *v_src, void *opts) {
   free(src);
 }
 
+/**
+ * frees an given TSPRoute created by init_tsp_route_at
+ *
+ * complexity is in O(1) 
+ */
+void free_tsp_route_at(void *v_src, void *opts) {
+  
+  (void) opts;
+  free(v_src);
+}
+
 /**  sets the distance of the road 
  * at the given index from the given TSP
  */
@@ -391,6 +881,144 @@ void mutate_tsp_route_switch(Individual *iv, void *opts) {
   //TODO remove roads pointer array and recombinate not used!!
 }
 
+/**
+ * returns the road of the patch at the given index of the route
+ * (copied from the route on first access)
+ *
+ * complexity is in O(1) 
+ */
+static TSPRoad *tsp_delta_road(TSPDelta *delta, 
+                               TSPRoute *route, 
+                               uint32_t index) {
+  uint32_t i;
+  for (i = 0; i < delta->num_roads; i++)
+    if (delta->index[i] == index)
+      return &delta->roads[i];
+
+  delta->index[i] = index;
+  delta->roads[i] = route->roads[index];
+  delta->num_roads++;
+
+  return &delta->roads[i];
+}
+
+/**
+ * writes the patch of switching two random citys 
+ * of an given TSPRoute (see mutate_tsp_route_switch)
+ * without changing the route
+ *
+ * complexity is in O(1) 
+ */
+void mutate_tsp_route_delta(Individual *parent, void *v_delta, void *opts) {
+
+  TSPEvolution *tsp_ev = opts;
+  TSPRoute     *route  = parent->iv;
+  TSPDelta     *delta  = v_delta;
+ 
+  uint32_t start = rand128(tsp_ev->rand) % (route->length - 1);
+  uint32_t end   = 1 + (rand128(tsp_ev->rand) % (route->length - 1));
+  uint32_t tmp, i;
+  TSPRoad *road_start, *road_start1, *road_end, *road_end1;
+
+  delta->num_roads = 0;
+  road_start  = tsp_delta_road(delta, route, start);
+  road_start1 = tsp_delta_road(delta, route, start + 1);
+  road_end    = tsp_delta_road(delta, route, end);
+  road_end1   = tsp_delta_road(delta, route, end - 1);
+
+  /* switch citys */
+  tmp                 = road_end1->city_b;
+  road_end1->city_b   = road_start->city_b;
+  road_start->city_b  = tmp;
+
+  tmp                 = road_end->city_a;
+  road_end->city_a    = road_start1->city_a;
+  road_start1->city_a = tmp;
+
+  /* reset distances */
+  for (i = 0; i < delta->num_roads; i++)
+    delta->roads[i].distance = tsp_ev->tsp.distances[delta->roads[i].city_a]
+                                                    [delta->roads[i].city_b];
+}
+
+/**
+ * calculates the length of an given TSPRoute 
+ * with the given patch applied
+ *
+ * complexity is in O(1) 
+ */
+int64_t tsp_route_length_delta(Individual *parent, 
+                               void *v_delta, 
+                               void *opts) {
+  
+  (void) opts;
+  TSPRoute *route = parent->iv;
+  TSPDelta *delta = v_delta;
+  int64_t length  = parent->fitness;
+  uint32_t i;
+
+  for (i = 0; i < delta->num_roads; i++) {
+    length -= route->roads[delta->index[i]].distance;
+    length += delta->roads[i].distance;
+  }
+
+  return length;
+}
+
+/**
+ * applies the given patch to an given TSPRoute
+ *
+ * complexity is in O(1) 
+ */
+void apply_tsp_route_delta(void *v_route, void *v_delta, void *opts) {
+  
+  (void) opts;
+  TSPRoute *route = v_route;
+  TSPDelta *delta = v_delta;
+  uint32_t i;
+
+  for (i = 0; i < delta->num_roads; i++) {
+    route->roads[delta->index[i]] = delta->roads[i];
+    route->citys[delta->roads[i].city_a] = &route->roads[delta->index[i]];
+  }
+}
+
+/**
+ * switches two random citys of an given TSPRoute in place
+ * and logs the replaced roads into the undo patch
+ *
+ * complexity is in O(1) 
+ */
+void mutate_tsp_route_undoable(Individual *iv, void *v_undo, void *opts) {
+  
+  TSPRoute *route = iv->iv;
+  TSPDelta *undo  = v_undo;
+  TSPRoad  tmp;
+  uint32_t i;
+
+  /* the patch of the switch is exchanged with the roads it replaces */
+  mutate_tsp_route_delta(iv, undo, opts);
+
+  for (i = 0; i < undo->num_roads; i++) {
+    tmp                          = route->roads[undo->index[i]];
+    route->roads[undo->index[i]] = undo->roads[i];
+    undo->roads[i]               = tmp;
+
+    route->citys[route->roads[undo->index[i]].city_a] = 
+      &route->roads[undo->index[i]];
+  }
+}
+
+/**
+ * reverts the last switch of an given TSPRoute
+ * (see mutate_tsp_route_undoable)
+ *
+ * complexity is in O(1) 
+ */
+void undo_tsp_route(Individual *iv, void *v_undo, void *opts) {
+  apply_tsp_route_delta(iv->iv, v_undo, opts);
+}
+
 /**
  * mutate an given TSPRoute 
  * by reinitalize an random length part
@@ -562,6 +1190,144 @@ void recombinate_tsp_route(Individual *src_1,
   }
 }
 
+/**
+ * writes the roads of an given TSPRoute into buf
+ * (returns 0 if they don't fit into size bytes)
+ *
+ * complexity is in O(n) 
+ * n = route->length
+ */
+size_t serialize_tsp_route(void *buf, size_t size, void *v_src, void *opts) {
+
+  (void) opts;
+  TSPRoute *src = v_src;
+
+  if (sizeof(TSPRoad) * src->length > size)
+    return 0;
+
+  memcpy(buf, src->roads, sizeof(TSPRoad) * src->length);
+
+  return sizeof(TSPRoad) * src->length;
+}
+
+/**
+ * restores an given TSPRoute from the roads in buf
+ *
+ * complexity is in O(n) 
+ * n = route->length
+ */
+void deserialize_tsp_route(void *v_dst, 
+                           const void *buf, 
+                           size_t size, 
+                           void *opts) {
+
+  (void) opts;
+  TSPRoute *dst = v_dst;
+
+  memcpy(dst->roads, buf, size);
+
+  /**
+   * change road pointer array so that it is sorted by city_a index
+   */
+  uint32_t i;
+  for (i = 0; i < dst->length; i++)
+    dst->citys[dst->roads[i].city_a] = &dst->roads[i];
+}
+
+/**
+ * runs the tsp evolution in one process of an multi process evolution
+ */
+int tsp_process(int index, void *arg) {
+
+  EvInitArgs *args = arg;
+  args->process_index = index;
+
+  Evolution *ev = new_evolution(args);
+  if (ev == NULL)
+    return 1;
+
+  Individual *best = evolute(ev);
+
+  #ifndef NO_OUTPUT
+  printf("process %d shortest found path: %" PRIi64 "\n", 
+         index, 
+         best->fitness);
+  #else
+  (void) best;
+  #endif
+
+  return 0;
+}
+
+/**
+ * runs one of the Evolutions sharing a pool
+ */
+void *tsp_shared(void *arg) {
+
+  EvInitArgs *args = (EvInitArgs *) arg;
+  Evolution *ev    = new_evolution(args);
+  if (ev == NULL) {
+    printf("invalid shared args\n");
+    exit(1);
+  }
+
+  Individual *best = evolute(ev);
+
+  #ifndef NO_OUTPUT
+  printf("shared pool shortest found path: %" PRIi64 "\n", best->fitness);
+  #endif
+
+  /* the other Evolutions on the pool may not mix into this one */
+  if (!check_tsp_route(best, args->opts[0])) {
+    printf("invalid shared best route\n");
+    exit(1);
+  }
+
+  if (!check_tsp_population(ev, args->population_size, 1)) {
+    printf("invalid shared population\n");
+    exit(1);
+  }
+
+  evolution_clean_up(ev);
+  return NULL;
+}
+
+/**
+ * async fitness: remembers the route, its length is
+ * calculated when it is completed (like an external process)
+ */
+void submit_tsp_route_length(Individual *iv, void *opts) {
+  
+  TSPEvolution *tsp_ev = opts;
+  tsp_ev->pending[tsp_ev->num_pending++] = iv;
+  tsp_ev->num_submitted++;
+}
+
+/**
+ * async fitness: calculates the length of the oldest submitted route
+ */
+Individual *complete_tsp_route_length(char wait, void *opts) {
+  
+  TSPEvolution *tsp_ev = opts;
+  Individual *iv;
+
+  /* only the oldest route is finished (if we wait for it) */
+  if (tsp_ev->num_pending == 0 || 
+      (!wait && tsp_ev->num_pending < TSP_MAX_PENDING / 2))
+    return NULL;
+
+  iv = tsp_ev->pending[0];
+  iv->fitness = tsp_route_length(iv, opts);
+
+  tsp_ev->num_pending--;
+  tsp_ev->num_completed++;
+  memmove(tsp_ev->pending, 
+          tsp_ev->pending + 1, 
+          sizeof(Individual *) * tsp_ev->num_pending);
+
+  return iv;
+}
+
 /**
  * continue_ev function which controls the art of 
  * mutation an gives extra output
@@ -606,4 +1372,365 @@ char tsp_continue_ev(Evolution *const ev) {
 }
 
 
+/**
+ * returns 1 if the route of an given Individual is a round trip from
+ * the start city wich visits each city once and the fitness of the
+ * Individual is the length of the route
+ *
+ * complexity is in O(n) 
+ * n = route->length
+ */
+char check_tsp_route(Individual *iv, TSPEvolution *tsp_ev) {
+
+  TSPRoute *route = iv->iv;
+  TSP      *tsp   = &tsp_ev->tsp;
+  TSPRoad  *road;
+
+  if (route->length != tsp->length ||
+      route->roads[0].city_a != tsp->start ||
+      route->roads[route->length - 1].city_b != tsp->start)
+    return 0;
+
+  char *visited = calloc(route->length, sizeof(char));
+
+  uint32_t i;
+  for (i = 0; i < route->length; i++) {
+    road = &route->roads[i];
+
+    if (road->city_a >= tsp->length || 
+        road->city_b >= tsp->length ||
+        visited[road->city_a] ||
+        road->distance != tsp->distances[road->city_a][road->city_b])
+      break;
+
+    /* the next road has to start where this one ends */
+    if (i + 1 < route->length && road->city_b != road[1].city_a)
+      break;
+
+    visited[road->city_a] = 1;
+  }
+
+  free(visited);
+  return i == route->length && iv->fitness == tsp_route_length(iv, tsp_ev);
+}
+
+/**
+ * returns 1 if the population of an given Evolution still 
+ * consists of n_ivs distinct Individuals with valid routes
+ * (sorted by their fitness if sorted is set)
+ *
+ * complexity is in O(n² + n * m) 
+ * n = population size
+ * m = route->length
+ */
+char check_tsp_population(Evolution *ev, int n_ivs, char sorted) {
+
+  Individual **population = ev->population;
+
+  if (ev->population_size != n_ivs)
+    return 0;
+
+  int i, j;
+  for (i = 0; i < n_ivs; i++) {
+    if (!check_tsp_route(population[i], *ev->opts))
+      return 0;
+
+    if (sorted && i > 0 && population[i - 1]->fitness > population[i]->fitness)
+      return 0;
+
+    for (j = 0; j < i; j++) {
+      if (population[j] == population[i] || 
+          population[j]->iv == population[i]->iv)
+        return 0;
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * returns 1 if each submitted route was completed (async fitness)
+ * Note: with only one thread the fitness is calculated synchronous
+ */
+char check_tsp_async(TSPEvolution **opts, int n_threads) {
+
+  uint64_t submitted = 0, completed = 0;
+
+  int i;
+  for (i = 0; i < n_threads; i++) {
+    if (opts[i]->num_pending != 0)
+      return 0;
+
+    submitted += opts[i]->num_submitted;
+    completed += opts[i]->num_completed;
+  }
+
+  return (submitted > 0 || n_threads == 1) && submitted == completed;
+}
+
+/**
+ * continue_ev function which checks the selection of the
+ * previous generation before calling tsp_continue_ev
+ */
+char tsp_check_continue_ev(Evolution *const ev) {
+
+  if (ev->info.generations_progressed > 0 && !check_tsp_selection(ev)) {
+    printf("wrong selection at generation %d\n", 
+           ev->info.generations_progressed);
+    exit(1);
+  }
+
+  return tsp_continue_ev(ev);
+}
+
+/**
+ * function for sorting the fitness values for check_tsp_selection
+ */
+static int compare_fitness(const void *a, const void *b) {
+  int64_t x = *(const int64_t *) a;
+  int64_t y = *(const int64_t *) b;
+  
+  return (x > y) - (x < y);
+}
+
+/**
+ * returns 1 if the survivors of an given Evolution are the best 
+ * Individuals of a full sort of the population and the best one 
+ * is at index zero
+ *
+ * complexity is in O(n log n) 
+ * n = population size
+ */
+char check_tsp_selection(Evolution *ev) {
+
+  int n = ev->population_size;
+  int k = ev->survivors;
+  int64_t *all      = malloc(sizeof(int64_t) * n);
+  int64_t *survived = malloc(sizeof(int64_t) * k);
+  char valid        = 1;
+
+  int i;
+  for (i = 0; i < n; i++)
+    all[i] = ev->population[i]->fitness;
+
+  memcpy(survived, all, sizeof(int64_t) * k);
+
+  /* the baseline: the whole population sorted */
+  qsort(all, n, sizeof(int64_t), compare_fitness);
+  qsort(survived, k, sizeof(int64_t), compare_fitness);
+
+  if (ev->population[0]->fitness != all[0])
+    valid = 0;
+
+  for (i = 0; i < k; i++)
+    if (survived[i] != all[i])
+      valid = 0;
+
+  free(all);
+  free(survived);
+  return valid;
+}
+
+/**
+ * returns 1 if the routes of a clone patched with mutate_tsp_route_delta
+ * and of a clone switched with mutate_tsp_route_undoable are the same as
+ * the route of a clone switched with mutate_tsp_route_switch (and the 
+ * undo restores the parent) for n random switches in a row
+ *
+ * complexity is in O(n * m) 
+ * m = route->length
+ */
+char check_tsp_patches(TSPEvolution *tsp_ev, int n) {
+
+  Individual parent, switched, patched, undone;
+  TSPDelta delta, undo;
+  rand128_t rand;
+  size_t size;
+  char valid = 1;
+
+  parent.iv   = init_tsp_route(tsp_ev);
+  switched.iv = init_tsp_route(tsp_ev);
+  patched.iv  = init_tsp_route(tsp_ev);
+  undone.iv   = init_tsp_route(tsp_ev);
+  size        = sizeof(TSPRoad) * ((TSPRoute *) parent.iv)->length;
+
+  parent.fitness = tsp_route_length(&parent, tsp_ev);
+
+  int i;
+  for (i = 0; i < n && valid; i++) {
+
+    /* all three versions use the same random switch */
+    rand = *tsp_ev->rand;
+    clone_tsp_route(switched.iv, parent.iv, tsp_ev);
+    mutate_tsp_route_switch(&switched, tsp_ev);
+    switched.fitness = tsp_route_length(&switched, tsp_ev);
+
+    *tsp_ev->rand = rand;
+    mutate_tsp_route_delta(&parent, &delta, tsp_ev);
+    clone_tsp_route(patched.iv, parent.iv, tsp_ev);
+    apply_tsp_route_delta(patched.iv, &delta, tsp_ev);
+    patched.fitness = tsp_route_length_delta(&parent, &delta, tsp_ev);
+
+    *tsp_ev->rand = rand;
+    clone_tsp_route(undone.iv, parent.iv, tsp_ev);
+    mutate_tsp_route_undoable(&undone, &undo, tsp_ev);
+    undone.fitness = tsp_route_length(&undone, tsp_ev);
+
+    valid = check_tsp_route(&switched, tsp_ev) &&
+            check_tsp_route(&patched, tsp_ev) &&
+            !memcmp(((TSPRoute *) patched.iv)->roads, 
+                    ((TSPRoute *) switched.iv)->roads, 
+                    size) &&
+            !memcmp(((TSPRoute *) undone.iv)->roads, 
+                    ((TSPRoute *) switched.iv)->roads, 
+                    size);
+
+    undo_tsp_route(&undone, &undo, tsp_ev);
+    valid = valid && !memcmp(((TSPRoute *) undone.iv)->roads, 
+                             ((TSPRoute *) parent.iv)->roads, 
+                             size);
+
+    /* the next switch starts from this one */
+    clone_tsp_route(parent.iv, switched.iv, tsp_ev);
+    parent.fitness = switched.fitness;
+  }
+
+  free_tsp_route(parent.iv, tsp_ev);
+  free_tsp_route(switched.iv, tsp_ev);
+  free_tsp_route(patched.iv, tsp_ev);
+  free_tsp_route(undone.iv, tsp_ev);
+  return valid;
+}
+
+/**
+ * fitness of the parent with the given id (not linear in the id,
+ * so the proportional weights differ from the rank weights),
+ * the children are worse than all parents
+ */
+static int64_t parent_fitness(int64_t id) {
+  return id < 0 ? INT32_MAX : id * id + 1;
+}
+
+static void *init_parent_id(void *opts) {
+  TSPParentCounts *counts = opts;
+  int64_t *id = malloc(sizeof(int64_t));
+
+  *id = counts->next_id++;
+  return id;
+}
+
+static void clone_parent_id(void *dst, void *src, void *opts) {
+  (void) opts;
+  *(int64_t *) dst = *(int64_t *) src;
+}
+
+static void free_parent_id(void *src, void *opts) {
+  (void) opts;
+  free(src);
+}
+
+static int64_t parent_id_fitness(Individual *iv, void *opts) {
+  (void) opts;
+  return parent_fitness(*(int64_t *) iv->iv);
+}
+
+/**
+ * counts the first parent and creates an child wich dies 
+ * in the next selection, so the parents stay the same
+ */
+static void recombinate_parent_id(Individual *src_1,
+                                  Individual *src_2,
+                                  Individual *dst,
+                                  void *opts) {
+  TSPParentCounts *counts = opts;
+  (void) src_2;
+
+  counts->picks[*(int64_t *) src_1->iv]++;
+  *(int64_t *) dst->iv = -1;
+}
+
+static char parent_continue_ev(Evolution *const ev) {
+  (void) ev;
+  return 1;
+}
+
+/**
+ * returns 1 if the first parents picked on a fixed population of 
+ * TSP_PARENTS_SIZE ids (with the given parent selection over the 
+ * surviving half) in n_generations generations match the weights of
+ * the selection: the distance to the worst survivor plus one for
+ * EV_PARENT_PROPORTIONAL and survivors - rank for EV_PARENT_RANK
+ *
+ * Note: each survivor is allowed to differ by 0.01 from its 
+ *       probability, with 5000 generations this is about 
+ *       six standard deviations
+ *
+ * complexity is in O(n * g) 
+ * n = TSP_PARENTS_SIZE
+ * g = n_generations
+ */
+char check_tsp_parents(uint32_t selection, int n_generations) {
+
+  TSPParentCounts counts;
+  EvInitArgs args;
+  void *opts[1] = { &counts };
+  int survivors = TSP_PARENTS_SIZE / 2;
+  double weights[TSP_PARENTS_SIZE], sum = 0;
+  uint64_t total = 0;
+  char valid = 1;
+  int i;
+
+  memset(&counts, 0, sizeof(TSPParentCounts));
+  memset(&args, 0, sizeof(EvInitArgs));
+
+  args.init_iv          = init_parent_id;
+  args.clone_iv         = clone_parent_id;
+  args.free_iv          = free_parent_id;
+  args.fitness          = parent_id_fitness;
+  args.recombinate      = recombinate_parent_id;
+  args.continue_ev      = parent_continue_ev;
+  args.population_size  = TSP_PARENTS_SIZE;
+  args.generation_limit = n_generations;
+  args.death_percentage = 0.5;
+  args.opts             = opts;
+  args.num_threads      = 1;
+  args.flags            = EV_UREC|EV_KEEP|selection;
+
+  Evolution *ev = new_evolution(&args);
+  if (ev == NULL)
+    return 0;
+
+  evolute(ev);
+  evolution_clean_up(ev);
+  free(ev);
+
+  /* the survivors are the ids [0, survivors) sorted by their id */
+  for (i = 0; i < survivors; i++) {
+    if (selection == EV_PARENT_PROPORTIONAL)
+      weights[i] = parent_fitness(survivors - 1) - parent_fitness(i) + 1;
+    else
+      weights[i] = survivors - i;
+
+    sum   += weights[i];
+    total += counts.picks[i];
+  }
+
+  for (i = survivors; i < TSP_PARENTS_SIZE; i++)
+    if (counts.picks[i] != 0)
+      valid = 0;
+
+  if (total == 0)
+    return 0;
+
+  double diff;
+  for (i = 0; i < survivors; i++) {
+    diff = (double) counts.picks[i] / total - weights[i] / sum;
+
+    if (diff > 0.01 || diff < -0.01)
+      valid = 0;
+  }
+
+  return valid;
+}
+
 #endif /* __TSP__ */
@@ -9,6 +9,12 @@
 #include "../src/evolution.h"
 #include "../src/C-Utils/Rand/src/rand.h"
 
+/**
+ * max number of routes wich fitness is calculated 
+ * asynchronous at the same time by one thread
+ */
+#define TSP_MAX_PENDING 8
+
 /**
  * uint32_t array
  */
@@ -34,6 +40,16 @@ typedef struct {
                     /* for better accessing an specific city        */
 } TSPRoute;
 
+/**
+ * patch of an TSPRoute: the roads changed by one switch mutation
+ * (see mutate_tsp_route_delta)
+ */
+typedef struct {
+  uint32_t num_roads;   /* number of changed roads */
+  uint32_t index[4];    /* index of each changed road in the route */
+  TSPRoad  roads[4];    /* the changed roads */
+} TSPDelta;
+
 /**
  * The TSP Matrix index [a][b] is the distance between
  * city a and city b
@@ -56,6 +72,25 @@ typedef struct {
   UI32Ary tmp;              /* temp array for calculation */
   double  mut_size_reduce;  /* pecentage to controll the mutation size */
   rand128_t *rand;          /* random value */
+  Individual *pending[TSP_MAX_PENDING]; /* submitted routes (async fitness) */
+  uint32_t num_pending;     /* number of submitted routes */
+  uint64_t num_submitted;   /* routes submitted so far (async fitness) */
+  uint64_t num_completed;   /* routes completed so far (async fitness) */
 } TSPEvolution;
 
+/**
+ * size of the fixed population for counting the parent picks
+ * (half of them survive, see check_tsp_parents)
+ */
+#define TSP_PARENTS_SIZE 20
+
+/**
+ * counts the picks of the first parent of each recombination,
+ * each genome is an int64_t id wich fixes its fitness (-1 for children)
+ */
+typedef struct {
+  int64_t next_id;                  /* id of the next initialized genome */
+  uint64_t picks[TSP_PARENTS_SIZE]; /* number of picks of each id */
+} TSPParentCounts;
+
 #endif /* __TSP_H__ */